@@ -0,0 +1,303 @@
+// Glyph pipeline micro-benchmarks (CPU only, no GL context)
+// Usage: GlyphPipelineBench <font.ttf>... [--face N] [--text STRING] [--iterations N]
+//                           [--per-glyph] [--json FILE]
+//        With no --text, uses printable ASCII (32-126), same as LoadFont().
+//
+// Each stage runs in isolation on inputs prepared by the stage before it:
+// 1. extract    : stbtt_GetGlyphShape + stbtt_FreeShape
+// 2. flatten    : FlattenCurve over the glyph's quadratic segments
+// 3. add_point  : AddPoint (duplicate check + push) over the flattened outline
+// 4. earcut     : front face triangulation
+// 5. side_walls : side-wall index generation
+// 6. full_mesh  : TessellateGlyph, i.e. everything CreateGlyphMesh does before the upload
+// 7. decode     : DecodeGlyph of the glyph's archive blob (what a .glyphs load or
+//                 an evicted glyph's re-upload does instead of 1-6)
+//
+// Per font: median over iterations of one pass over the whole glyph set.
+// Per glyph (--per-glyph): median over iterations of each glyph on its own.
+
+#include "core/GlyphTessellator.h"
+#include "core/GlyphArchive.h"
+#include "core/FontFile.h"
+#include "core/GlyphCorpus.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps the optimizer from deleting the work
+static volatile size_t s_Sink = 0;
+
+static double Nanoseconds(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double, std::nano>(b - a).count();
+}
+
+static double Median(std::vector<double> v) {
+    if (v.empty()) return 0.0;
+    std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+    return v[v.size() / 2];
+}
+
+// Everything each stage needs as input, prepared once per glyph
+struct GlyphInput {
+    uint32_t codepoint = 0;
+    int glyphIndex = 0;
+    std::vector<stbtt_vertex> shape;    // Copy of stbtt_GetGlyphShape's output
+    GlyphPolygon polygon;               // Flattened outline
+    size_t triangles = 0;
+    EncodedGlyph encoded;               // Archive blob of the full mesh
+};
+
+struct Stage {
+    const char* name;
+    std::function<void(const GlyphInput&)> run;
+};
+
+struct StageResult {
+    double fontNs = 0.0;                // One pass over all glyphs
+    std::vector<double> glyphNs;        // Per glyph, same order as the inputs
+};
+
+static std::vector<Stage> MakeStages(const stbtt_fontinfo* info) {
+    std::vector<Stage> stages;
+
+    stages.push_back({ "extract", [info](const GlyphInput& g) {
+        stbtt_vertex* verts;
+        int n = stbtt_GetGlyphShape(info, g.glyphIndex, &verts);
+        stbtt_FreeShape(info, verts);
+        s_Sink = s_Sink + n;
+    } });
+
+    stages.push_back({ "flatten", [](const GlyphInput& g) {
+        static std::vector<GlyphPoint> poly;
+        poly.clear();
+        float curX = 0, curY = 0;
+        for (const stbtt_vertex& v : g.shape) {
+            if (v.type == STBTT_vcurve) FlattenCurve(poly, curX, curY, v.cx, v.cy, v.x, v.y);
+            curX = v.x; curY = v.y;
+        }
+        s_Sink = s_Sink + poly.size();
+    } });
+
+    stages.push_back({ "add_point", [](const GlyphInput& g) {
+        static std::vector<GlyphPoint> poly;
+        size_t total = 0;
+        for (const auto& ring : g.polygon) {
+            poly.clear();
+            for (const GlyphPoint& p : ring) AddPoint(poly, (float)p[0], (float)p[1]);
+            total += poly.size();
+        }
+        s_Sink = s_Sink + total;
+    } });
+
+    stages.push_back({ "earcut", [](const GlyphInput& g) {
+        s_Sink = s_Sink + TriangulateGlyphOutline(g.polygon).size();
+    } });
+
+    stages.push_back({ "side_walls", [](const GlyphInput& g) {
+        static std::vector<uint32_t> indices;
+        indices.clear();
+        size_t points = 0;
+        for (const auto& ring : g.polygon) points += ring.size();
+        AppendGlyphSideWalls(g.polygon, (uint32_t)points, indices);
+        s_Sink = s_Sink + indices.size();
+    } });
+
+    stages.push_back({ "full_mesh", [info](const GlyphInput& g) {
+        GlyphGeometry geometry;
+        TessellateGlyph(info, g.glyphIndex, geometry);
+        s_Sink = s_Sink + geometry.indices.size();
+    } });
+
+    stages.push_back({ "decode", [](const GlyphInput& g) {
+        static std::vector<float> vertices;
+        static std::vector<uint32_t> indices;
+        const GlyphArchiveEntry& e = g.encoded.entry;
+        if (vertices.size() < (size_t)e.vertexCount * 6) vertices.resize((size_t)e.vertexCount * 6);
+        if (indices.size() < e.indexCount) indices.resize(e.indexCount);
+        bool ok = DecodeGlyph(e, g.encoded.data.data(), vertices.data(), indices.data());
+        s_Sink = s_Sink + ok;
+    } });
+
+    return stages;
+}
+
+static StageResult RunStage(const Stage& stage, const std::vector<GlyphInput>& glyphs, int iterations, bool perGlyph) {
+    StageResult result;
+    std::vector<double> passes;
+    std::vector<std::vector<double>> samples(glyphs.size());
+
+    for (const GlyphInput& g : glyphs) stage.run(g);    // Warm up caches and allocations
+
+    for (int it = 0; it < iterations; it++) {
+        auto t0 = Clock::now();
+        for (const GlyphInput& g : glyphs) stage.run(g);
+        passes.push_back(Nanoseconds(t0, Clock::now()));
+
+        if (!perGlyph) continue;
+        for (size_t i = 0; i < glyphs.size(); i++) {
+            auto g0 = Clock::now();
+            stage.run(glyphs[i]);
+            samples[i].push_back(Nanoseconds(g0, Clock::now()));
+        }
+    }
+
+    result.fontNs = Median(passes);
+    if (perGlyph) {
+        for (const auto& s : samples) result.glyphNs.push_back(Median(s));
+    }
+    return result;
+}
+
+static std::string JsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> fontPaths;
+    int faceIndex = 0;
+    int iterations = 15;
+    bool perGlyph = false;
+    std::string jsonPath;
+    GlyphCorpus corpus;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--face" && i + 1 < argc) faceIndex = std::atoi(argv[++i]);
+        else if (arg == "--text" && i + 1 < argc) corpus.AddString(argv[++i]);
+        else if (arg == "--iterations" && i + 1 < argc) iterations = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--per-glyph") perGlyph = true;
+        else if (arg == "--json" && i + 1 < argc) jsonPath = argv[++i];
+        else if (arg.rfind("--", 0) == 0) { fprintf(stderr, "Unknown option: %s\n", arg.c_str()); return 1; }
+        else fontPaths.push_back(arg);
+    }
+    if (fontPaths.empty()) {
+        fprintf(stderr, "Usage: GlyphPipelineBench <font.ttf>... [--face N] [--text STRING] [--iterations N]"
+                        " [--per-glyph] [--json FILE]\n");
+        return 1;
+    }
+
+    std::vector<uint32_t> codepoints = corpus.GetCodepoints();
+    if (codepoints.empty()) {
+        for (uint32_t cp = 32; cp <= 126; ++cp) codepoints.push_back(cp);
+    }
+
+    std::string json = "{\n  \"iterations\": " + std::to_string(iterations) + ",\n  \"fonts\": [";
+
+    for (size_t f = 0; f < fontPaths.size(); f++) {
+        // 1. Load Font
+        std::shared_ptr<FontFile> file = FontFile::Open(fontPaths[f]);
+        FontFace face;
+        if (!file || !face.Init(file, faceIndex)) {
+            fprintf(stderr, "Could not open font: %s (face %d)\n", fontPaths[f].c_str(), faceIndex);
+            return 1;
+        }
+        const stbtt_fontinfo* info = &face.info;
+
+        // 2. Stage inputs (blank glyphs such as space have nothing to tessellate)
+        std::vector<GlyphInput> glyphs;
+        for (uint32_t cp : codepoints) {
+            GlyphInput g;
+            g.codepoint = cp;
+            g.glyphIndex = stbtt_FindGlyphIndex(info, cp);
+            if (!ExtractGlyphOutline(info, g.glyphIndex, g.polygon)) continue;
+
+            stbtt_vertex* verts;
+            int n = stbtt_GetGlyphShape(info, g.glyphIndex, &verts);
+            g.shape.assign(verts, verts + n);
+            stbtt_FreeShape(info, verts);
+
+            g.triangles = TriangulateGlyphOutline(g.polygon).size() / 3;
+
+            GlyphGeometry geometry;
+            TessellateGlyph(info, g.glyphIndex, geometry);
+            EncodeGlyph(cp, geometry, g.encoded.entry, g.encoded.data);
+            glyphs.push_back(std::move(g));
+        }
+
+        // Decode throughput: the VBO/EBO bytes written, and the blob bytes read
+        double decodedBytes = 0.0, encodedBytes = 0.0;
+        for (const GlyphInput& g : glyphs) {
+            decodedBytes += g.encoded.entry.vertexCount * 6.0 * sizeof(float) + g.encoded.entry.indexCount * 4.0;
+            encodedBytes += g.encoded.data.size();
+        }
+
+        // 3. Run
+        std::vector<Stage> stages = MakeStages(info);
+        std::vector<StageResult> results;
+        for (const Stage& stage : stages) results.push_back(RunStage(stage, glyphs, iterations, perGlyph));
+
+        // 4. Report
+        printf("\n%s (%zu glyphs)\n", fontPaths[f].c_str(), glyphs.size());
+        printf("  %-12s %12s %12s\n", "stage", "font (ms)", "ns/glyph");
+        for (size_t s = 0; s < stages.size(); s++) {
+            double perGlyphAvg = glyphs.empty() ? 0.0 : results[s].fontNs / glyphs.size();
+            printf("  %-12s %12.3f %12.1f\n", stages[s].name, results[s].fontNs * 1e-6, perGlyphAvg);
+        }
+        double decodeNs = results.back().fontNs;
+        if (decodeNs > 0.0) {
+            printf("  decode: %.2f GB/s written, %.2f GB/s read\n", decodedBytes / decodeNs, encodedBytes / decodeNs);
+        }
+
+        if (perGlyph) {
+            printf("\n  %-8s %6s", "glyph", "tris");
+            for (const Stage& stage : stages) printf(" %11s", stage.name);
+            printf("   (ns)\n");
+            for (size_t i = 0; i < glyphs.size(); i++) {
+                printf("  U+%04X   %6zu", glyphs[i].codepoint, glyphs[i].triangles);
+                for (const StageResult& r : results) printf(" %11.0f", r.glyphNs[i]);
+                printf("\n");
+            }
+        }
+
+        char buf[256];
+        json += f == 0 ? "\n" : ",\n";
+        json += "    {\n      \"font\": \"" + JsonEscape(fontPaths[f]) + "\",\n";
+        json += "      \"glyphs\": " + std::to_string(glyphs.size()) + ",\n      \"stages\": {";
+        for (size_t s = 0; s < stages.size(); s++) {
+            snprintf(buf, sizeof(buf), "%s\n        \"%s\": { \"font_ms\": %.4f, \"ns_per_glyph\": %.1f }",
+                     s == 0 ? "" : ",", stages[s].name, results[s].fontNs * 1e-6,
+                     glyphs.empty() ? 0.0 : results[s].fontNs / glyphs.size());
+            json += buf;
+        }
+        json += "\n      }";
+        if (perGlyph) {
+            json += ",\n      \"per_glyph\": [";
+            for (size_t i = 0; i < glyphs.size(); i++) {
+                snprintf(buf, sizeof(buf), "%s\n        { \"codepoint\": %u, \"triangles\": %zu",
+                         i == 0 ? "" : ",", glyphs[i].codepoint, glyphs[i].triangles);
+                json += buf;
+                for (size_t s = 0; s < stages.size(); s++) {
+                    snprintf(buf, sizeof(buf), ", \"%s_ns\": %.0f", stages[s].name, results[s].glyphNs[i]);
+                    json += buf;
+                }
+                json += " }";
+            }
+            json += "\n      ]";
+        }
+        json += "\n    }";
+    }
+    json += "\n  ]\n}\n";
+
+    if (!jsonPath.empty()) {
+        FILE* out = fopen(jsonPath.c_str(), "w");
+        if (!out || fputs(json.c_str(), out) < 0) {
+            fprintf(stderr, "Could not write: %s\n", jsonPath.c_str());
+            if (out) fclose(out);
+            return 1;
+        }
+        fclose(out);
+    }
+    return 0;
+}
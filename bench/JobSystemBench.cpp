@@ -0,0 +1,123 @@
+// JobSystem micro-benchmarks
+// Usage: JobSystemBench [maxWorkers]
+//
+// 1. Scheduling overhead: cost per empty job, submitted from outside and
+//    from inside a job (the worker-local push/pop path).
+// 2. Dependency chain: latency of RunAfter hand-offs.
+// 3. Scaling: a fixed amount of arithmetic through ParallelFor with 0..N
+//    workers, reported as speedup and efficiency against 1 thread.
+
+#include "core/JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double Seconds(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double>(b - a).count();
+}
+
+// Keeps the optimizer from deleting the work
+static volatile double s_Sink = 0.0;
+
+static double Burn(size_t begin, size_t end) {
+    double acc = 0.0;
+    for (size_t i = begin; i < end; i++) acc += std::sqrt((double)i) * std::sin((double)i);
+    return acc;
+}
+
+static void BenchOverhead(JobSystem& jobs) {
+    const int N = 200000;
+
+    // External thread -> shared queue
+    auto t0 = Clock::now();
+    JobCounter counter;
+    for (int i = 0; i < N; i++) jobs.Run([]() {}, &counter);
+    jobs.Wait(counter);
+    auto t1 = Clock::now();
+
+    // One job fanning out from a worker -> worker-local deque, stolen by the others
+    JobCounter outer, inner;
+    jobs.Run([&]() {
+        for (int i = 0; i < N; i++) jobs.Run([]() {}, &inner);
+    }, &outer);
+    jobs.Wait(outer);
+    jobs.Wait(inner);
+    auto t2 = Clock::now();
+
+    printf("  empty job, external submit : %7.1f ns/job\n", Seconds(t0, t1) * 1e9 / N);
+    printf("  empty job, worker submit   : %7.1f ns/job\n", Seconds(t1, t2) * 1e9 / N);
+}
+
+static void BenchChain(JobSystem& jobs) {
+    const int N = 20000;
+    std::vector<JobCounter> links(N);
+
+    auto t0 = Clock::now();
+    jobs.Run([]() {}, &links[0]);
+    for (int i = 1; i < N; i++) jobs.RunAfter(links[i - 1], []() {}, &links[i]);
+    jobs.Wait(links[N - 1]);
+    auto t1 = Clock::now();
+
+    // Every link must be done before the vector goes away
+    for (JobCounter& c : links) jobs.Wait(c);
+
+    printf("  dependency hand-off        : %7.1f ns/link\n", Seconds(t0, t1) * 1e9 / N);
+}
+
+static void BenchScaling(int maxWorkers) {
+    const size_t COUNT = 1 << 24;
+    const size_t GRAIN = 1 << 14;
+
+    // 1, 2, 4, ... threads (workers + the calling thread), always ending on maxWorkers
+    std::vector<int> workerCounts;
+    for (int threads = 1; threads - 1 < maxWorkers; threads *= 2) workerCounts.push_back(threads - 1);
+    workerCounts.push_back(maxWorkers);
+
+    double baseline = 0.0;
+    printf("  %-8s %10s %9s %11s\n", "threads", "time (ms)", "speedup", "efficiency");
+    for (int workers : workerCounts) {
+        JobSystem jobs(workers);
+        std::vector<double> partial(COUNT / GRAIN + 1, 0.0);
+
+        auto t0 = Clock::now();
+        jobs.ParallelFor(COUNT, GRAIN, [&](size_t begin, size_t end) {
+            partial[begin / GRAIN] = Burn(begin, end);
+        });
+        auto t1 = Clock::now();
+
+        double total = 0.0;
+        for (double p : partial) total += p;
+        s_Sink = s_Sink + total;
+
+        int threads = workers + 1;
+        double t = Seconds(t0, t1);
+        if (workers == 0) baseline = t;
+        double speedup = baseline / t;
+        printf("  %-8d %10.2f %8.2fx %10.0f%%\n", threads, t * 1e3, speedup, 100.0 * speedup / threads);
+    }
+}
+
+int main(int argc, char** argv) {
+    int hw = (int)std::thread::hardware_concurrency();
+    int maxWorkers = argc > 1 ? std::atoi(argv[1]) : std::max(hw - 1, 1);
+
+    printf("JobSystem bench (%d hardware threads)\n", hw);
+
+    {
+        JobSystem jobs(maxWorkers);
+        printf("\nOverhead (%d workers)\n", jobs.GetWorkerCount());
+        BenchOverhead(jobs);
+        BenchChain(jobs);
+    }
+
+    printf("\nScaling (%d M iterations)\n", (1 << 24) >> 20);
+    BenchScaling(maxWorkers);
+    return 0;
+}
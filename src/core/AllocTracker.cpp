@@ -0,0 +1,294 @@
+#include "AllocTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(GRAPHICSLAB_ALLOC_TRACKING) && !defined(NDEBUG) && __has_include(<execinfo.h>) && __has_include(<cxxabi.h>)
+#define ALLOC_CALLSITES 1
+#include <cxxabi.h>
+#include <execinfo.h>
+#else
+#define ALLOC_CALLSITES 0
+#endif
+
+// Stack capture skips a fixed number of frames, so the hook's own frames
+// must not depend on the optimizer's inlining decisions
+#if defined(__GNUC__)
+#define ALLOC_INLINE inline __attribute__((always_inline))
+#define ALLOC_NOINLINE __attribute__((noinline))
+#else
+#define ALLOC_INLINE inline
+#define ALLOC_NOINLINE
+#endif
+
+namespace {
+// Constant-initialized: valid before any static constructor allocates
+std::atomic<uint64_t> s_Allocations{ 0 };
+std::atomic<uint64_t> s_Frees{ 0 };
+std::atomic<uint64_t> s_Bytes{ 0 };
+
+AllocFrameStats s_Last;
+AllocFrameStats s_FrameStart;      // Totals at the last BeginFrame
+
+AllocFrameStats Totals() {
+    AllocFrameStats t;
+    t.allocations = s_Allocations.load(std::memory_order_relaxed);
+    t.frees = s_Frees.load(std::memory_order_relaxed);
+    t.bytes = s_Bytes.load(std::memory_order_relaxed);
+    return t;
+}
+
+#if ALLOC_CALLSITES
+// --------------------------------------------------------
+// CALL SITES
+// --------------------------------------------------------
+// Fixed open-addressing table keyed by the return addresses, so recording
+// never allocates. Sites beyond the table are counted but not attributed.
+const int MAX_DEPTH = 16;
+const int SKIP_FRAMES = 2;          // RecordCallsite + operator new
+const size_t MAX_SITES = 1024;
+
+struct Callsite {
+    void* frames[MAX_DEPTH];
+    int depth = 0;
+    uint64_t hash = 0;
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+Callsite s_Sites[MAX_SITES];
+uint64_t s_Unattributed = 0;
+std::mutex s_SitesLock;
+std::atomic<bool> s_Capture{ false };
+thread_local bool t_InHook = false;     // backtrace() may allocate the first time
+
+ALLOC_NOINLINE void RecordCallsite(size_t size) {
+    if (t_InHook) return;
+    t_InHook = true;
+
+    void* frames[MAX_DEPTH + SKIP_FRAMES];
+    int depth = backtrace(frames, MAX_DEPTH + SKIP_FRAMES) - SKIP_FRAMES;
+    if (depth > 0) {
+        // FNV-1a over the addresses
+        uint64_t hash = 1469598103934665603ull;
+        for (int i = 0; i < depth; i++) hash = (hash ^ (uint64_t)(uintptr_t)frames[SKIP_FRAMES + i]) * 1099511628211ull;
+        hash |= 1;      // 0 marks a free slot
+
+        std::lock_guard<std::mutex> lock(s_SitesLock);
+        size_t slot = hash % MAX_SITES;
+        for (size_t probe = 0; probe < MAX_SITES; probe++, slot = (slot + 1) % MAX_SITES) {
+            Callsite& site = s_Sites[slot];
+            if (site.hash == 0) {
+                site.hash = hash;
+                site.depth = depth;
+                std::memcpy(site.frames, frames + SKIP_FRAMES, depth * sizeof(void*));
+            }
+            if (site.hash == hash) {
+                site.count++;
+                site.bytes += size;
+                depth = 0;
+                break;
+            }
+        }
+        if (depth > 0) s_Unattributed++;
+    }
+    t_InHook = false;
+}
+
+// "binary(_ZN3Foo3barEv+0x1c) [0x...]" -> "Foo::bar() +0x1c"
+void PrintFrame(const char* symbol) {
+    const char* open = std::strchr(symbol, '(');
+    const char* plus = open ? std::strchr(open, '+') : nullptr;
+    const char* close = plus ? std::strchr(plus, ')') : nullptr;
+    if (!open || !plus || !close || plus == open + 1) {
+        fprintf(stderr, "      %s\n", symbol);
+        return;
+    }
+
+    std::string mangled(open + 1, plus);
+    int status = 0;
+    char* name = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+    fprintf(stderr, "      %s %.*s\n", status == 0 ? name : mangled.c_str(), (int)(close - plus), plus);
+    free(name);
+}
+#endif
+
+ALLOC_INLINE void CountAlloc(size_t size) {
+    s_Allocations.fetch_add(1, std::memory_order_relaxed);
+    s_Bytes.fetch_add(size, std::memory_order_relaxed);
+#if ALLOC_CALLSITES
+    if (s_Capture.load(std::memory_order_relaxed)) RecordCallsite(size);
+#endif
+}
+
+ALLOC_INLINE void CountFree(void* p) {
+    if (p) s_Frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+// As the standard operator new: when the heap is exhausted, let the installed
+// new_handler free memory (or throw bad_alloc) and retry. Null without a handler.
+template <typename Alloc>
+ALLOC_INLINE void* RetryWithNewHandler(Alloc alloc) {
+    void* p = alloc();
+    while (!p) {
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) return nullptr;
+        handler();
+        p = alloc();
+    }
+    return p;
+}
+
+ALLOC_INLINE void* Allocate(size_t size) {
+    CountAlloc(size);
+    return RetryWithNewHandler([size]() { return std::malloc(size ? size : 1); });
+}
+
+ALLOC_INLINE void* AllocateAligned(size_t size, std::align_val_t align) {
+    CountAlloc(size);
+    size_t a = std::max((size_t)align, sizeof(void*));
+    size_t rounded = (std::max(size, (size_t)1) + a - 1) / a * a;
+    return RetryWithNewHandler([a, rounded]() { return std::aligned_alloc(a, rounded); });
+}
+}
+
+bool AllocTracker::IsCompiled() {
+#ifdef GRAPHICSLAB_ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool AllocTracker::CanCaptureCallsites() {
+    return ALLOC_CALLSITES != 0;
+}
+
+void AllocTracker::BeginFrame() {
+    AllocFrameStats now = Totals();
+    s_Last.allocations = now.allocations - s_FrameStart.allocations;
+    s_Last.frees = now.frees - s_FrameStart.frees;
+    s_Last.bytes = now.bytes - s_FrameStart.bytes;
+    s_FrameStart = now;
+}
+
+const AllocFrameStats& AllocTracker::GetLastFrame() {
+    return s_Last;
+}
+
+AllocFrameStats AllocTracker::GetTotals() {
+    return Totals();
+}
+
+void AllocTracker::SetCallsiteCapture(bool enabled) {
+#if ALLOC_CALLSITES
+    s_Capture.store(enabled, std::memory_order_relaxed);
+#else
+    (void)enabled;
+#endif
+}
+
+void AllocTracker::ClearCallsites() {
+#if ALLOC_CALLSITES
+    std::lock_guard<std::mutex> lock(s_SitesLock);
+    for (Callsite& site : s_Sites) site = Callsite();
+    s_Unattributed = 0;
+#endif
+}
+
+void AllocTracker::PrintCallsites(int maxSites) {
+#if ALLOC_CALLSITES
+    bool capturing = s_Capture.exchange(false);
+
+    // 1. Snapshot, most frequent first
+    std::vector<Callsite> sites;
+    uint64_t unattributed;
+    {
+        std::lock_guard<std::mutex> lock(s_SitesLock);
+        for (const Callsite& site : s_Sites) {
+            if (site.hash != 0) sites.push_back(site);
+        }
+        unattributed = s_Unattributed;
+    }
+    std::sort(sites.begin(), sites.end(), [](const Callsite& a, const Callsite& b) { return a.count > b.count; });
+
+    // 2. Symbolize (needs -rdynamic for names outside shared libraries)
+    fprintf(stderr, "Allocation call sites (%zu, top %d):\n", sites.size(), maxSites);
+    for (size_t i = 0; i < sites.size() && (int)i < maxSites; i++) {
+        const Callsite& site = sites[i];
+        fprintf(stderr, "  #%zu: %llu allocations, %llu bytes\n", i + 1, (unsigned long long)site.count,
+                (unsigned long long)site.bytes);
+        char** symbols = backtrace_symbols(site.frames, site.depth);
+        for (int f = 0; f < site.depth; f++) PrintFrame(symbols ? symbols[f] : "?");
+        free(symbols);
+    }
+    if (unattributed) fprintf(stderr, "  (%llu more in sites that didn't fit the table)\n", (unsigned long long)unattributed);
+
+    s_Capture.store(capturing);
+#else
+    (void)maxSites;
+    fprintf(stderr, "Allocation call sites need a debug build (no NDEBUG) with GRAPHICSLAB_ALLOC_TRACKING\n");
+#endif
+}
+
+// --------------------------------------------------------
+// GLOBAL OPERATOR NEW / DELETE
+// --------------------------------------------------------
+// The nothrow forms catch what a new_handler throws.
+#ifdef GRAPHICSLAB_ALLOC_TRACKING
+void* operator new(size_t size) {
+    if (void* p = Allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    if (void* p = Allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try { return Allocate(size); } catch (const std::bad_alloc&) { return nullptr; }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try { return Allocate(size); } catch (const std::bad_alloc&) { return nullptr; }
+}
+
+void* operator new(size_t size, std::align_val_t align) {
+    if (void* p = AllocateAligned(size, align)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t align) {
+    if (void* p = AllocateAligned(size, align)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    try { return AllocateAligned(size, align); } catch (const std::bad_alloc&) { return nullptr; }
+}
+
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    try { return AllocateAligned(size, align); } catch (const std::bad_alloc&) { return nullptr; }
+}
+
+void operator delete(void* p) noexcept { CountFree(p); std::free(p); }
+void operator delete[](void* p) noexcept { CountFree(p); std::free(p); }
+void operator delete(void* p, size_t) noexcept { CountFree(p); std::free(p); }
+void operator delete[](void* p, size_t) noexcept { CountFree(p); std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { CountFree(p); std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { CountFree(p); std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { CountFree(p); std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { CountFree(p); std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { CountFree(p); std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { CountFree(p); std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { CountFree(p); std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { CountFree(p); std::free(p); }
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Heap traffic through operator new/delete in one frame
+struct AllocFrameStats {
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t bytes = 0;             // Requested by the allocations
+};
+
+// Global operator new/delete hooks (CMake option GRAPHICSLAB_ALLOC_TRACKING).
+//
+// Every allocation bumps a few relaxed atomics, on any thread; BeginFrame()
+// on the render thread turns the counts since the previous call into
+// GetLastFrame(). malloc() calls from C libraries and the GL driver are not
+// seen, only C++ new/delete (std::string, std::vector, std::function, ...).
+//
+// Debug builds (no NDEBUG) can also attribute allocations to their call
+// stacks. Capturing a stack per allocation is slow, so it is off until
+// SetCallsiteCapture(true), typically only for steady-state frames.
+class AllocTracker {
+public:
+    // False when the hooks aren't compiled in: every count stays 0
+    static bool IsCompiled();
+    static bool CanCaptureCallsites();
+
+    // Frame boundary: the counts so far become GetLastFrame()
+    static void BeginFrame();
+    static const AllocFrameStats& GetLastFrame();
+
+    // Since startup
+    static AllocFrameStats GetTotals();
+
+    // --- Call sites (debug builds) ---
+    static void SetCallsiteCapture(bool enabled);
+    static void ClearCallsites();
+    // Most frequent first, with symbolized stacks, to stderr.
+    // Turns capture off while it runs (printing allocates).
+    static void PrintCallsites(int maxSites = 10);
+};
@@ -0,0 +1,236 @@
+#include "BatchedText.h"
+#include "GLStats.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+namespace {
+const int ATLAS_SIZE = 512;
+
+const char* batchVert = R"GLSL(
+#version 330 core
+layout(location = 0) in vec2 aPos;
+layout(location = 1) in vec2 aUV;
+layout(location = 2) in vec4 aColor;
+uniform vec2 uScreen;
+out vec2 vUV;
+out vec4 vColor;
+void main() {
+    vUV = aUV;
+    vColor = aColor;
+    gl_Position = vec4(aPos.x / uScreen.x * 2.0 - 1.0, 1.0 - aPos.y / uScreen.y * 2.0, 0.0, 1.0);
+}
+)GLSL";
+
+const char* batchFrag = R"GLSL(
+#version 330 core
+in vec2 vUV;
+in vec4 vColor;
+uniform sampler2D uAtlas;
+out vec4 FragColor;
+void main() {
+    FragColor = vec4(vColor.rgb, vColor.a * texture(uAtlas, vUV).r);
+}
+)GLSL";
+
+GLuint CompileProgram() {
+    GLuint vs = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vs, 1, &batchVert, NULL);
+    glCompileShader(vs);
+    GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fs, 1, &batchFrag, NULL);
+    glCompileShader(fs);
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cerr << "BatchedText: shader error: " << infoLog << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+// 0xRRGGBBAA -> bytes R, G, B, A in memory
+uint32_t PackColor(uint32_t rgba) {
+    return ((rgba >> 24) & 0xFF) | (((rgba >> 16) & 0xFF) << 8) | (((rgba >> 8) & 0xFF) << 16) | ((rgba & 0xFF) << 24);
+}
+}
+
+bool BatchedText::Init(const std::string& fontPath, float pixelHeight, int faceIndex) {
+    // 1. Font, through the same shared mapping TextRenderer3D uses
+    m_File = FontFile::Open(fontPath);
+    FontFace face;
+    if (!m_File || !face.Init(m_File, faceIndex)) {
+        m_File.reset();
+        return false;
+    }
+
+    // 2. Bake ASCII 32..127. Baking starts at (1, 1), so texel (0, 0) is free for solid fills.
+    std::vector<unsigned char> atlas(ATLAS_SIZE * ATLAS_SIZE);
+    stbtt_bakedchar baked[96];
+    int offset = stbtt_GetFontOffsetForIndex(m_File->GetData(), faceIndex);
+    if (stbtt_BakeFontBitmap(m_File->GetData(), offset, pixelHeight, atlas.data(), ATLAS_SIZE, ATLAS_SIZE, 32, 96, baked) == 0) {
+        return false;
+    }
+    atlas[0] = 255;
+    m_SolidU = m_SolidV = 0.5f / ATLAS_SIZE;
+
+    for (int i = 0; i < 96; i++) {
+        const stbtt_bakedchar& b = baked[i];
+        m_Chars[i] = { b.x0 / (float)ATLAS_SIZE, b.y0 / (float)ATLAS_SIZE, b.x1 / (float)ATLAS_SIZE, b.y1 / (float)ATLAS_SIZE,
+                       b.xoff, b.yoff, (float)(b.x1 - b.x0), (float)(b.y1 - b.y0), b.xadvance };
+    }
+
+    int ascent, descent, lineGap;
+    stbtt_GetFontVMetrics(&face.info, &ascent, &descent, &lineGap);
+    float scale = stbtt_ScaleForPixelHeight(&face.info, pixelHeight);
+    m_Ascent = ascent * scale;
+    m_LineHeight = (ascent - descent + lineGap) * scale;
+
+    // 3. GL objects: atlas, a vertex buffer refilled per batch, static quad indices
+    glGenTextures(1, &m_Texture);
+    glBindTexture(GL_TEXTURE_2D, m_Texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_SIZE, ATLAS_SIZE, 0, GL_RED, GL_UNSIGNED_BYTE, atlas.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    std::vector<uint16_t> indices(MAX_QUADS * 6);
+    for (size_t q = 0; q < MAX_QUADS; q++) {
+        uint16_t v = (uint16_t)(q * 4);
+        uint16_t quad[6] = { v, (uint16_t)(v + 1), (uint16_t)(v + 2), v, (uint16_t)(v + 2), (uint16_t)(v + 3) };
+        std::copy(quad, quad + 6, &indices[q * 6]);
+    }
+
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_VBO);
+    glGenBuffers(1, &m_EBO);
+    glBindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, x));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, u));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+    glEnableVertexAttribArray(2);
+    glBindVertexArray(0);
+
+    m_Program = CompileProgram();
+    if (!m_Program) {
+        Release();
+        return false;
+    }
+    m_ScreenLoc = glGetUniformLocation(m_Program, "uScreen");
+    glUseProgram(m_Program);
+    glUniform1i(glGetUniformLocation(m_Program, "uAtlas"), 0);
+    glUseProgram(0);
+
+    m_Vertices.reserve(MAX_QUADS * 4);
+    return true;
+}
+
+void BatchedText::Release() {
+    glDeleteTextures(1, &m_Texture);
+    glDeleteVertexArrays(1, &m_VAO);
+    glDeleteBuffers(1, &m_VBO);
+    glDeleteBuffers(1, &m_EBO);
+    if (m_Program) glDeleteProgram(m_Program);
+    m_Texture = m_VAO = m_VBO = m_EBO = m_Program = 0;
+    m_Uploaded = false;
+    m_File.reset();
+}
+
+void BatchedText::Begin(int screenWidth, int screenHeight) {
+    m_Vertices.clear();
+    m_Uploaded = false;
+    m_Width = screenWidth;
+    m_Height = screenHeight;
+}
+
+void BatchedText::AddQuad(float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, uint32_t rgba) {
+    if (m_Vertices.size() + 4 > MAX_QUADS * 4) return;
+    uint32_t c = PackColor(rgba);
+    m_Vertices.push_back({ x0, y0, u0, v0, c });
+    m_Vertices.push_back({ x1, y0, u1, v0, c });
+    m_Vertices.push_back({ x1, y1, u1, v1, c });
+    m_Vertices.push_back({ x0, y1, u0, v1, c });
+}
+
+float BatchedText::AddText(const char* text, float x, float y, uint32_t rgba) {
+    // 'y' is the top of the line; baked offsets are relative to the baseline
+    float baseline = y + m_Ascent;
+    for (; *text; text++) {
+        int c = (unsigned char)*text;
+        if (c < 32 || c >= 128) c = '?';
+        const BakedChar& b = m_Chars[c - 32];
+        if (b.w > 0) {
+            // Whole pixels keep small text crisp
+            float x0 = (float)(int)(x + b.xoff + 0.5f);
+            float y0 = (float)(int)(baseline + b.yoff + 0.5f);
+            AddQuad(x0, y0, x0 + b.w, y0 + b.h, b.u0, b.v0, b.u1, b.v1, rgba);
+        }
+        x += b.advance;
+    }
+    return x;
+}
+
+float BatchedText::MeasureText(const char* text) const {
+    float width = 0.0f;
+    for (; *text; text++) {
+        int c = (unsigned char)*text;
+        if (c < 32 || c >= 128) c = '?';
+        width += m_Chars[c - 32].advance;
+    }
+    return width;
+}
+
+void BatchedText::AddRect(float x, float y, float w, float h, uint32_t rgba) {
+    AddQuad(x, y, x + w, y + h, m_SolidU, m_SolidV, m_SolidU, m_SolidV, rgba);
+}
+
+void BatchedText::Draw() {
+    if (!IsValid() || m_Vertices.empty()) return;
+
+    // 1. Upload a new batch, sized to what it holds: fresh storage, so this
+    // never waits on a draw still reading the previous one
+    if (!m_Uploaded) {
+        glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+        glBufferData(GL_ARRAY_BUFFER, m_Vertices.size() * sizeof(Vertex), m_Vertices.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        m_Uploaded = true;
+    }
+
+    // 2. One draw, alpha blended on top of whatever the scene left
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    glDisable(GL_DEPTH_TEST);
+    // Alpha accumulates as coverage, so into a cleared target this leaves
+    // premultiplied color that can be composited later
+    glEnable(GL_BLEND);
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    glUseProgram(m_Program);
+    glUniform2f(m_ScreenLoc, (float)m_Width, (float)m_Height);
+    glActiveTexture(GL_TEXTURE0);
+    GLStats::BindTexture(GL_TEXTURE_2D, m_Texture);
+    glBindVertexArray(m_VAO);
+    GLStats::DrawElements(GL_TRIANGLES, (GLsizei)(m_Vertices.size() / 4 * 6), GL_UNSIGNED_SHORT, 0);
+    glBindVertexArray(0);
+
+    glDisable(GL_BLEND);
+    if (depthTest) glEnable(GL_DEPTH_TEST);
+}
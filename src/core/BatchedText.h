@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <GL/glew.h>
+#include "FontFile.h"
+
+// Flat 2D text (and solid rectangles) for overlays, in one draw call.
+// Uses the same font mapping as TextRenderer3D (FontFile), but instead of
+// extruded meshes it bakes printable ASCII into a small alpha atlas and
+// emits one textured quad per character. Begin() / Add*() / Draw() to
+// replace the batch; Draw() alone redraws the last one without uploading it
+// again. The vertex storage is reserved up front, so a frame allocates nothing.
+//
+// Coordinates are pixels with the origin at the top-left, like the cursor.
+class BatchedText {
+public:
+    static const size_t MAX_QUADS = 4096;      // Beyond this, Add*() drops quads
+
+    // Needs the context current
+    bool Init(const std::string& fontPath, float pixelHeight, int faceIndex = 0);
+    void Release();
+    bool IsValid() const { return m_Program != 0; }
+
+    void Begin(int screenWidth, int screenHeight);
+    // Returns the x where the text ends. 'rgba' is 0xRRGGBBAA.
+    float AddText(const char* text, float x, float y, uint32_t rgba);
+    void AddRect(float x, float y, float w, float h, uint32_t rgba);
+    float MeasureText(const char* text) const;
+    void Draw();
+
+    float GetLineHeight() const { return m_LineHeight; }
+
+private:
+    struct Vertex {
+        float x, y, u, v;
+        uint32_t color;             // Bytes R, G, B, A
+    };
+
+    struct BakedChar {
+        float u0, v0, u1, v1;
+        float xoff, yoff, w, h, advance;
+    };
+
+    void AddQuad(float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, uint32_t rgba);
+
+    std::shared_ptr<FontFile> m_File;
+    BakedChar m_Chars[96] = {};
+    float m_SolidU = 0.0f, m_SolidV = 0.0f;    // A texel that is always opaque
+    float m_LineHeight = 0.0f, m_Ascent = 0.0f;
+
+    std::vector<Vertex> m_Vertices;
+    bool m_Uploaded = false;        // m_VBO holds m_Vertices
+    int m_Width = 0, m_Height = 0;
+
+    GLuint m_Texture = 0, m_VAO = 0, m_VBO = 0, m_EBO = 0, m_Program = 0;
+    GLint m_ScreenLoc = -1;
+};
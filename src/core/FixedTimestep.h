@@ -0,0 +1,36 @@
+#pragma once
+
+// Fixed-step simulation clock.
+// Real frame time goes in, a whole number of fixed steps comes out, and the
+// leftover fraction is the interpolation alpha for rendering. The step count
+// is capped so one slow frame can't snowball into ever longer catch-up frames.
+class FixedTimestep {
+    double m_Step;
+    int m_MaxSteps;
+    double m_Accumulator = 0.0;
+
+public:
+    FixedTimestep(double step = 1.0 / 60.0, int maxSteps = 5)
+        : m_Step(step), m_MaxSteps(maxSteps) {}
+
+    // Returns how many OnUpdate(step) calls to run this frame
+    int Advance(double elapsed) {
+        if (elapsed < 0.0) elapsed = 0.0;
+        m_Accumulator += elapsed;
+
+        int steps = (int)(m_Accumulator / m_Step);
+        if (steps > m_MaxSteps) {
+            // Too far behind: run the cap and drop the backlog
+            steps = m_MaxSteps;
+            m_Accumulator = m_Step * steps;
+        }
+        m_Accumulator -= m_Step * steps;
+        return steps;
+    }
+
+    // How far we are between the last two simulated states (0..1)
+    float GetAlpha() const { return (float)(m_Accumulator / m_Step); }
+
+    float GetStep() const { return (float)m_Step; }
+    void Reset() { m_Accumulator = 0.0; }
+};
@@ -0,0 +1,73 @@
+#include "FontFile.h"
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+
+// POSIX file mapping
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+// Path -> live mapping. Weak, so a file is unmapped once the last face using it goes away.
+std::mutex s_RegistryMutex;
+std::map<std::string, std::weak_ptr<FontFile>> s_Registry;
+}
+
+FontFile::~FontFile() {
+    if (m_Data) munmap((void*)m_Data, m_Size);
+}
+
+std::shared_ptr<FontFile> FontFile::Open(const std::string& path) {
+    std::error_code ec;
+    std::string key = std::filesystem::weakly_canonical(path, ec).string();
+    if (ec) key = path;
+
+    std::lock_guard<std::mutex> lock(s_RegistryMutex);
+
+    auto it = s_Registry.find(key);
+    if (it != s_Registry.end()) {
+        if (auto existing = it->second.lock()) return existing;
+    }
+
+    // 1. Map the file
+    int fd = open(key.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) { close(fd); return nullptr; }
+
+    void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return nullptr;
+
+    std::shared_ptr<FontFile> file(new FontFile());
+    file->m_Path = key;
+    file->m_Data = (const unsigned char*)data;
+    file->m_Size = (size_t)st.st_size;
+
+    // 2. Reject anything stb_truetype can't index
+    if (file->GetFaceCount() <= 0) return nullptr;
+
+    s_Registry[key] = file;
+    return file;
+}
+
+int FontFile::GetFaceCount() const {
+    int count = stbtt_GetNumberOfFonts(m_Data);
+    return count < 0 ? 0 : count;
+}
+
+bool FontFace::Init(const std::shared_ptr<FontFile>& fontFile, int index) {
+    file.reset();
+    if (!fontFile || index < 0 || index >= fontFile->GetFaceCount()) return false;
+
+    int offset = stbtt_GetFontOffsetForIndex(fontFile->GetData(), index);
+    if (offset < 0 || !stbtt_InitFont(&info, fontFile->GetData(), offset)) return false;
+
+    file = fontFile;
+    faceIndex = index;
+    return true;
+}
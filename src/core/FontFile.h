@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include "../libs/stb_truetype.h"
+
+// A font file (.ttf / .otf / .ttc) mapped read-only into memory.
+// Open() hands out one shared mapping per file, so every face of a collection,
+// and every renderer using it, reads from the same pages.
+class FontFile {
+    std::string m_Path;                  // Canonical path, used as cache key
+    const unsigned char* m_Data = nullptr;
+    size_t m_Size = 0;
+
+    FontFile() = default;
+
+public:
+    ~FontFile();
+    FontFile(const FontFile&) = delete;
+    FontFile& operator=(const FontFile&) = delete;
+
+    static std::shared_ptr<FontFile> Open(const std::string& path);
+
+    const std::string& GetPath() const { return m_Path; }
+    const unsigned char* GetData() const { return m_Data; }
+    size_t GetSize() const { return m_Size; }
+
+    // 1 for a plain font, N for a collection, 0 if the data isn't a font
+    int GetFaceCount() const;
+};
+
+// One face inside a FontFile. Cheap to copy: the outline data stays in the mapping.
+struct FontFace {
+    std::shared_ptr<FontFile> file;
+    int faceIndex = 0;
+    stbtt_fontinfo info{};
+
+    bool Init(const std::shared_ptr<FontFile>& fontFile, int index);
+    bool IsValid() const { return file != nullptr; }
+};
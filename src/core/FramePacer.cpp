@@ -0,0 +1,75 @@
+#include "FramePacer.h"
+
+#include <thread>
+
+namespace {
+// Below this, stop trusting sleep and spin instead
+const auto SPIN_MARGIN = std::chrono::microseconds(1500);
+
+double ToMs(FramePacer::Clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+}
+
+void FramePacer::Release() {
+    for (GLsync fence : m_Fences) glDeleteSync(fence);
+    m_Fences.clear();
+}
+
+void FramePacer::Configure(int maxFramesInFlight, double maxFps) {
+    m_MaxFramesInFlight = maxFramesInFlight;
+    m_Period = maxFps > 0.0
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / maxFps))
+        : Clock::duration(0);
+    m_Deadline = Clock::now() + m_Period;
+}
+
+void FramePacer::EndFrame() {
+    LimitFramesInFlight();
+    WaitForDeadline();
+}
+
+void FramePacer::LimitFramesInFlight() {
+    m_LastGpuWaitMs = 0.0;
+    if (m_MaxFramesInFlight <= 0) return;
+
+    m_Fences.push_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+    auto start = Clock::now();
+    while ((int)m_Fences.size() > m_MaxFramesInFlight) {
+        // Flush so the fence can't sit in an unsubmitted command buffer forever
+        glClientWaitSync(m_Fences.front(), GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+        glDeleteSync(m_Fences.front());
+        m_Fences.pop_front();
+    }
+
+    // Drop fences that have already passed, without waiting
+    while (!m_Fences.empty()) {
+        GLenum state = glClientWaitSync(m_Fences.front(), 0, 0);
+        if (state != GL_ALREADY_SIGNALED && state != GL_CONDITION_SATISFIED) break;
+        glDeleteSync(m_Fences.front());
+        m_Fences.pop_front();
+    }
+    m_LastGpuWaitMs = ToMs(Clock::now() - start);
+}
+
+void FramePacer::WaitForDeadline() {
+    m_LastCapWaitMs = 0.0;
+    if (m_Period == Clock::duration(0)) return;
+
+    auto start = Clock::now();
+
+    // 1. Coarse sleep
+    if (m_Deadline - start > SPIN_MARGIN) std::this_thread::sleep_for(m_Deadline - start - SPIN_MARGIN);
+
+    // 2. Spin to the exact deadline
+    while (Clock::now() < m_Deadline) std::this_thread::yield();
+
+    // Next deadline is one period on; after a long frame, restart from now
+    // rather than rushing several frames to catch up
+    auto now = Clock::now();
+    m_Deadline += m_Period;
+    if (m_Deadline < now) m_Deadline = now + m_Period;
+
+    m_LastCapWaitMs = ToMs(now - start);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <GL/glew.h>
+
+// Everything between SwapBuffers and the next input poll that decides when
+// the next frame may start:
+//   - frames in flight: a fence per swapped frame; if more than N are still
+//     queued on the GPU, wait for the oldest. Keeps the CPU from running
+//     ahead and sampling input for a frame that won't show for a while.
+//   - frame cap: sleep most of the remaining time, spin the last bit
+//     (OS sleeps overshoot by up to a millisecond or two).
+// Vsync itself is glfwSwapInterval, set by the host.
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // maxFramesInFlight 0 = unlimited, maxFps 0 = uncapped
+    void Configure(int maxFramesInFlight, double maxFps);
+
+    // Call right after SwapBuffers
+    void EndFrame();
+
+    // Time spent blocked in the last EndFrame (ms)
+    double GetLastGpuWaitMs() const { return m_LastGpuWaitMs; }
+    double GetLastCapWaitMs() const { return m_LastCapWaitMs; }
+
+    // Deletes the pending fences (needs the context; call before it goes away)
+    void Release();
+
+private:
+    void LimitFramesInFlight();
+    void WaitForDeadline();
+
+    int m_MaxFramesInFlight = 2;
+    Clock::duration m_Period{ 0 };
+    Clock::time_point m_Deadline{};
+    std::deque<GLsync> m_Fences;        // Oldest first
+
+    double m_LastGpuWaitMs = 0.0;
+    double m_LastCapWaitMs = 0.0;
+};
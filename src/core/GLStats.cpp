@@ -0,0 +1,147 @@
+#include "GLStats.h"
+
+#include <cstdio>
+
+namespace {
+bool s_Installed = false;
+thread_local bool t_Counting = false;      // The render thread, once installed
+GLFrameStats s_Current, s_Last;
+
+uint64_t Triangles(GLenum mode, GLsizei count, GLsizei instances = 1) {
+    uint64_t perInstance = 0;
+    switch (mode) {
+    case GL_TRIANGLES: perInstance = count / 3; break;
+    case GL_TRIANGLE_STRIP:
+    case GL_TRIANGLE_FAN: perInstance = count > 2 ? count - 2 : 0; break;
+    default: break;
+    }
+    return perInstance * (uint64_t)instances;
+}
+
+void CountDraw(GLenum mode, GLsizei count, GLsizei instances = 1) {
+    if (!t_Counting) return;
+    s_Current.drawCalls++;
+    s_Current.triangles += Triangles(mode, count, instances);
+}
+
+// --------------------------------------------------------
+// WRAPPERS (GLEW function pointers)
+// --------------------------------------------------------
+// Each keeps the original pointer in s_<Name> and forwards to it
+#define GLSTATS_WRAP(Name, Pfn, Params, Args, Count) \
+    Pfn s_##Name = nullptr; \
+    void GLAPIENTRY Hook##Name Params { if (t_Counting) { Count; } s_##Name Args; }
+
+GLSTATS_WRAP(UseProgram, PFNGLUSEPROGRAMPROC, (GLuint p), (p), s_Current.programBinds++)
+GLSTATS_WRAP(BindVertexArray, PFNGLBINDVERTEXARRAYPROC, (GLuint a), (a), s_Current.vertexArrayBinds++)
+GLSTATS_WRAP(BindBuffer, PFNGLBINDBUFFERPROC, (GLenum t, GLuint b), (t, b), s_Current.bufferBinds++)
+GLSTATS_WRAP(BufferData, PFNGLBUFFERDATAPROC, (GLenum t, GLsizeiptr n, const void* d, GLenum u), (t, n, d, u),
+             if (d) s_Current.bufferBytes += n)
+GLSTATS_WRAP(BufferSubData, PFNGLBUFFERSUBDATAPROC, (GLenum t, GLintptr o, GLsizeiptr n, const void* d), (t, o, n, d),
+             s_Current.bufferBytes += n)
+
+GLSTATS_WRAP(Uniform1f, PFNGLUNIFORM1FPROC, (GLint l, GLfloat x), (l, x), s_Current.uniformUploads++)
+GLSTATS_WRAP(Uniform1i, PFNGLUNIFORM1IPROC, (GLint l, GLint x), (l, x), s_Current.uniformUploads++)
+GLSTATS_WRAP(Uniform2f, PFNGLUNIFORM2FPROC, (GLint l, GLfloat x, GLfloat y), (l, x, y), s_Current.uniformUploads++)
+GLSTATS_WRAP(Uniform3f, PFNGLUNIFORM3FPROC, (GLint l, GLfloat x, GLfloat y, GLfloat z), (l, x, y, z),
+             s_Current.uniformUploads++)
+GLSTATS_WRAP(Uniform4f, PFNGLUNIFORM4FPROC, (GLint l, GLfloat x, GLfloat y, GLfloat z, GLfloat w), (l, x, y, z, w),
+             s_Current.uniformUploads++)
+GLSTATS_WRAP(Uniform3fv, PFNGLUNIFORM3FVPROC, (GLint l, GLsizei n, const GLfloat* v), (l, n, v), s_Current.uniformUploads++)
+GLSTATS_WRAP(Uniform4fv, PFNGLUNIFORM4FVPROC, (GLint l, GLsizei n, const GLfloat* v), (l, n, v), s_Current.uniformUploads++)
+GLSTATS_WRAP(UniformMatrix3fv, PFNGLUNIFORMMATRIX3FVPROC, (GLint l, GLsizei n, GLboolean t, const GLfloat* v), (l, n, t, v),
+             s_Current.uniformUploads++)
+GLSTATS_WRAP(UniformMatrix4fv, PFNGLUNIFORMMATRIX4FVPROC, (GLint l, GLsizei n, GLboolean t, const GLfloat* v), (l, n, t, v),
+             s_Current.uniformUploads++)
+
+GLSTATS_WRAP(DrawRangeElements, PFNGLDRAWRANGEELEMENTSPROC,
+             (GLenum m, GLuint s, GLuint e, GLsizei c, GLenum t, const void* i), (m, s, e, c, t, i), CountDraw(m, c))
+GLSTATS_WRAP(DrawElementsInstanced, PFNGLDRAWELEMENTSINSTANCEDPROC,
+             (GLenum m, GLsizei c, GLenum t, const void* i, GLsizei n), (m, c, t, i, n), CountDraw(m, c, n))
+GLSTATS_WRAP(DrawArraysInstanced, PFNGLDRAWARRAYSINSTANCEDPROC,
+             (GLenum m, GLint f, GLsizei c, GLsizei n), (m, f, c, n), CountDraw(m, c, n))
+GLSTATS_WRAP(DrawElementsBaseVertex, PFNGLDRAWELEMENTSBASEVERTEXPROC,
+             (GLenum m, GLsizei c, GLenum t, const void* i, GLint b), (m, c, t, i, b), CountDraw(m, c))
+
+#undef GLSTATS_WRAP
+
+// Mapped ranges opened for writing count as uploaded in full
+PFNGLMAPBUFFERRANGEPROC s_MapBufferRange = nullptr;
+void* GLAPIENTRY HookMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+    if (t_Counting && (access & GL_MAP_WRITE_BIT)) s_Current.bufferBytes += length;
+    return s_MapBufferRange(target, offset, length, access);
+}
+}
+
+void GLStats::Install() {
+    // Only entry points the driver actually provides get wrapped. A pointer
+    // that is already our hook is left alone (Install twice without a
+    // glewInit in between); anything else is a fresh driver pointer.
+#define GLSTATS_HOOK(Name) \
+    if (__glew##Name && __glew##Name != Hook##Name) { s_##Name = __glew##Name; __glew##Name = Hook##Name; }
+    GLSTATS_HOOK(UseProgram)
+    GLSTATS_HOOK(BindVertexArray)
+    GLSTATS_HOOK(BindBuffer)
+    GLSTATS_HOOK(BufferData)
+    GLSTATS_HOOK(BufferSubData)
+    GLSTATS_HOOK(MapBufferRange)
+    GLSTATS_HOOK(Uniform1f)
+    GLSTATS_HOOK(Uniform1i)
+    GLSTATS_HOOK(Uniform2f)
+    GLSTATS_HOOK(Uniform3f)
+    GLSTATS_HOOK(Uniform4f)
+    GLSTATS_HOOK(Uniform3fv)
+    GLSTATS_HOOK(Uniform4fv)
+    GLSTATS_HOOK(UniformMatrix3fv)
+    GLSTATS_HOOK(UniformMatrix4fv)
+    GLSTATS_HOOK(DrawRangeElements)
+    GLSTATS_HOOK(DrawElementsInstanced)
+    GLSTATS_HOOK(DrawArraysInstanced)
+    GLSTATS_HOOK(DrawElementsBaseVertex)
+#undef GLSTATS_HOOK
+
+    s_Installed = true;
+    t_Counting = true;
+}
+
+bool GLStats::IsInstalled() {
+    return s_Installed;
+}
+
+void GLStats::BeginFrame() {
+    s_Last = s_Current;
+    s_Current = GLFrameStats();
+}
+
+const GLFrameStats& GLStats::GetLastFrame() {
+    return s_Last;
+}
+
+int FormatFrameStats(const GLFrameStats& s, char* buf, size_t size) {
+    return snprintf(buf, size, "%u draws, %.1fk tris, %u clears, binds: %u prog %u vao %u buf %u tex, %u uniforms, %llu KB",
+             s.drawCalls, s.triangles / 1000.0, s.clears, s.programBinds, s.vertexArrayBinds, s.bufferBinds,
+             s.textureBinds, s.uniformUploads, (unsigned long long)(s.bufferBytes / 1024));
+}
+
+// --------------------------------------------------------
+// CORE 1.1
+// --------------------------------------------------------
+void GLStats::DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+    CountDraw(mode, count);
+    glDrawElements(mode, count, type, indices);
+}
+
+void GLStats::DrawArrays(GLenum mode, GLint first, GLsizei count) {
+    CountDraw(mode, count);
+    glDrawArrays(mode, first, count);
+}
+
+void GLStats::Clear(GLbitfield mask) {
+    if (t_Counting) s_Current.clears++;
+    glClear(mask);
+}
+
+void GLStats::BindTexture(GLenum target, GLuint texture) {
+    if (t_Counting) s_Current.textureBinds++;
+    glBindTexture(target, texture);
+}
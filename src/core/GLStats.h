@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <GL/glew.h>
+
+// What the render thread asked GL to do in one frame
+struct GLFrameStats {
+    uint32_t drawCalls = 0;
+    uint64_t triangles = 0;         // Submitted, before culling
+    uint32_t clears = 0;
+    uint32_t programBinds = 0;
+    uint32_t vertexArrayBinds = 0;
+    uint32_t bufferBinds = 0;
+    uint32_t textureBinds = 0;
+    uint32_t uniformUploads = 0;
+    uint64_t bufferBytes = 0;       // glBufferData / glBufferSubData / mapped writes
+};
+
+// One line into 'buf' (snprintf rules), e.g.
+// "12 draws, 4.1k tris, 2 clears, binds: 1 prog 12 vao 0 buf 0 tex, 13 uniforms, 0 KB"
+int FormatFrameStats(const GLFrameStats& stats, char* buf, size_t size);
+
+// Optional instrumented GL dispatch (--gl-stats).
+//
+// GLEW reaches everything past GL 1.1 through global function pointers, so
+// Install() swaps those for counting wrappers that forward to the originals.
+// Core 1.1 entry points (glDrawElements, glClear, ...) are plain exports of
+// libGL with no pointer to swap: draw and clear sites that should be counted
+// call the GLStats:: versions below explicitly. Those forward straight to GL
+// (plus one thread-local check) when --gl-stats is off.
+//
+// Only calls made on the thread that called Install() are counted, so
+// uploads on the scene loader's context don't leak into the frame.
+class GLStats {
+public:
+    // After every glewInit, with the context current: glewInit reloads the
+    // pointers, so each new context needs hooking again. Without it nothing is wrapped.
+    static void Install();
+    static bool IsInstalled();
+
+    // Frame boundary on the render thread: the frame so far becomes GetLastFrame()
+    static void BeginFrame();
+    static const GLFrameStats& GetLastFrame();
+
+    // Core 1.1, counted versions
+    static void DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices);
+    static void DrawArrays(GLenum mode, GLint first, GLsizei count);
+    static void Clear(GLbitfield mask);
+    static void BindTexture(GLenum target, GLuint texture);
+};
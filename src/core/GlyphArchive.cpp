@@ -0,0 +1,304 @@
+#include "GlyphArchive.h"
+#include "GlyphTessellator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+// File layout (little-endian, as written by the host):
+//   ArchiveHeader
+//   GlyphArchiveEntry[glyphCount]
+//   per-glyph blobs, each 4-byte aligned:
+//     uint16 x[n] | uint16 y[n] | uint16 z[n] | int8 oct[2n] | varint indices
+namespace {
+
+const char kMagic[4] = { 'G', 'L', 'Y', 'A' };
+const uint32_t kVersion = 1;
+
+struct ArchiveHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t glyphCount;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(ArchiveHeader) == 16, "Archive header must be packed");
+static_assert(sizeof(GlyphArchiveEntry) == 48, "Archive entry must be packed");
+
+// --- ENCODING HELPERS ---
+uint16_t Quantize(float v, float lo, float hi) {
+    if (hi <= lo) return 0;
+    float t = (v - lo) / (hi - lo);
+    t = std::min(std::max(t, 0.0f), 1.0f);
+    return (uint16_t)std::lround(t * 65535.0f);
+}
+
+int8_t ToSnorm8(float v) {
+    v = std::min(std::max(v, -1.0f), 1.0f);
+    return (int8_t)std::lround(v * 127.0f);
+}
+
+float SignNotZero(float v) { return v >= 0.0f ? 1.0f : -1.0f; }
+
+void EncodeOctahedral(float nx, float ny, float nz, int8_t& u, int8_t& v) {
+    float l1 = std::abs(nx) + std::abs(ny) + std::abs(nz);
+    if (l1 <= 0.0f) { u = 0; v = 0; return; }
+    float px = nx / l1;
+    float py = ny / l1;
+    if (nz < 0.0f) {
+        float fx = (1.0f - std::abs(py)) * SignNotZero(px);
+        float fy = (1.0f - std::abs(px)) * SignNotZero(py);
+        px = fx; py = fy;
+    }
+    u = ToSnorm8(px);
+    v = ToSnorm8(py);
+}
+
+void PutVarint(std::vector<uint8_t>& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+// --- DECODING HELPERS ---
+inline uint16_t LoadU16(const uint8_t* p, uint32_t i) {
+    uint16_t v;
+    std::memcpy(&v, p + i * 2, sizeof(v));
+    return v;
+}
+
+// Slow path for multi-byte or truncated varints
+bool GetVarintChecked(const uint8_t*& p, const uint8_t* end, uint32_t& out) {
+    uint32_t v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (p >= end) return false;
+        uint8_t b = *p++;
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (b < 0x80) { out = v; return true; }
+    }
+    return false;
+}
+
+} // namespace
+
+// --------------------------------------------------------
+// SINGLE GLYPH CODEC
+// --------------------------------------------------------
+void EncodeGlyph(uint32_t codepoint, const GlyphGeometry& geometry, GlyphArchiveEntry& e, std::vector<uint8_t>& data) {
+    e = GlyphArchiveEntry{};
+    e.codepoint = codepoint;
+    e.advance = geometry.advance;
+    e.vertexCount = (uint32_t)(geometry.vertices.size() / 6);
+    e.indexCount = (uint32_t)geometry.indices.size();
+
+    // 1. Quantization frame
+    const float* v = geometry.vertices.data();
+    if (e.vertexCount > 0) {
+        e.minX = e.maxX = v[0];
+        e.minY = e.maxY = v[1];
+        e.minZ = e.maxZ = v[2];
+    }
+    for (uint32_t i = 1; i < e.vertexCount; ++i) {
+        const float* p = v + i * 6;
+        e.minX = std::min(e.minX, p[0]); e.maxX = std::max(e.maxX, p[0]);
+        e.minY = std::min(e.minY, p[1]); e.maxY = std::max(e.maxY, p[1]);
+        e.minZ = std::min(e.minZ, p[2]); e.maxZ = std::max(e.maxZ, p[2]);
+    }
+
+    // 2. Blob, appended to 'data'
+    e.dataOffset = (uint32_t)data.size();
+    size_t n = e.vertexCount;
+    size_t start = data.size();
+    data.resize(start + n * 8);
+    uint8_t* blob = data.data() + start;
+
+    for (size_t i = 0; i < n; ++i) {
+        const float* p = v + i * 6;
+        uint16_t qx = Quantize(p[0], e.minX, e.maxX);
+        uint16_t qy = Quantize(p[1], e.minY, e.maxY);
+        uint16_t qz = Quantize(p[2], e.minZ, e.maxZ);
+        std::memcpy(blob + i * 2, &qx, 2);
+        std::memcpy(blob + n * 2 + i * 2, &qy, 2);
+        std::memcpy(blob + n * 4 + i * 2, &qz, 2);
+
+        int8_t ou, ov;
+        EncodeOctahedral(p[3], p[4], p[5], ou, ov);
+        blob[n * 6 + i * 2 + 0] = (uint8_t)ou;
+        blob[n * 6 + i * 2 + 1] = (uint8_t)ov;
+    }
+
+    // 3. Index stream: delta + zigzag + varint
+    uint32_t prev = 0;
+    for (uint32_t idx : geometry.indices) {
+        int32_t delta = (int32_t)(idx - prev);
+        uint32_t zz = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+        PutVarint(data, zz);
+        prev = idx;
+    }
+
+    e.dataSize = (uint32_t)(data.size() - start);
+}
+
+bool DecodeGlyph(const GlyphArchiveEntry& e, const uint8_t* blob, float* vertexOut, uint32_t* indexOut) {
+    const uint32_t n = e.vertexCount;
+
+    const uint8_t* xs = blob;
+    const uint8_t* ys = blob + n * 2;
+    const uint8_t* zs = blob + n * 4;
+    const int8_t* oct = (const int8_t*)(blob + n * 6);
+
+    // 1. Positions: one multiply-add per component, no branches.
+    //    Frame copied to locals: the output floats could otherwise alias 'e'.
+    const float ox = e.minX, oy = e.minY, oz = e.minZ;
+    const float sx = (e.maxX - e.minX) / 65535.0f;
+    const float sy = (e.maxY - e.minY) / 65535.0f;
+    const float sz = (e.maxZ - e.minZ) / 65535.0f;
+    for (uint32_t i = 0; i < n; ++i) {
+        float* out = vertexOut + i * 6;
+        out[0] = ox + (float)LoadU16(xs, i) * sx;
+        out[1] = oy + (float)LoadU16(ys, i) * sy;
+        out[2] = oz + (float)LoadU16(zs, i) * sz;
+    }
+
+    // 2. Normals: octahedral unfold, written with min/max/copysign so it stays branch-free
+    for (uint32_t i = 0; i < n; ++i) {
+        float u = std::max((float)oct[i * 2 + 0] * (1.0f / 127.0f), -1.0f);
+        float v = std::max((float)oct[i * 2 + 1] * (1.0f / 127.0f), -1.0f);
+        float z = 1.0f - std::abs(u) - std::abs(v);
+        float t = std::max(-z, 0.0f);
+        u -= std::copysign(t, u);
+        v -= std::copysign(t, v);
+        float inv = 1.0f / std::sqrt(u * u + v * v + z * z);
+        float* out = vertexOut + i * 6;
+        out[3] = u * inv;
+        out[4] = v * inv;
+        out[5] = z * inv;
+    }
+
+    // 3. Indices: while a full 5-byte varint still fits, decode without bounds checks;
+    //    single-byte deltas (the common case) are one load and one compare.
+    const uint8_t* p = blob + n * 8;
+    const uint8_t* end = blob + e.dataSize;
+    const uint32_t indexCount = e.indexCount;
+    uint32_t prev = 0;
+    uint32_t outOfRange = 0;
+    uint32_t i = 0;
+    for (; i < indexCount && end - p >= 5; ++i) {
+        uint32_t zz = p[0];
+        if (zz < 0x80) {
+            p += 1;
+        } else {
+            zz &= 0x7F;
+            uint32_t b;
+            int shift = 7;
+            const uint8_t* q = p + 1;
+            do {
+                b = *q++;
+                zz |= (b & 0x7F) << shift;
+                shift += 7;
+            } while (b >= 0x80 && shift < 35);
+            if (b >= 0x80) return false;
+            p = q;
+        }
+        prev += (zz >> 1) ^ (0u - (zz & 1));
+        outOfRange |= (uint32_t)(prev >= n);
+        indexOut[i] = prev;
+    }
+    for (; i < indexCount; ++i) {
+        uint32_t zz;
+        if (!GetVarintChecked(p, end, zz)) return false;
+        prev += (zz >> 1) ^ (0u - (zz & 1));
+        outOfRange |= (uint32_t)(prev >= n);
+        indexOut[i] = prev;
+    }
+    return outOfRange == 0;
+}
+
+// --------------------------------------------------------
+// WRITER
+// --------------------------------------------------------
+void GlyphArchiveWriter::AddGlyph(uint32_t codepoint, const GlyphGeometry& geometry) {
+    // Offset is relative to the data block until Write()
+    GlyphArchiveEntry e;
+    EncodeGlyph(codepoint, geometry, e, m_Data);
+
+    // Keep every blob 4-byte aligned so the uint16 streams are aligned too
+    while (m_Data.size() % 4 != 0) m_Data.push_back(0);
+
+    m_Entries.push_back(e);
+}
+
+bool GlyphArchiveWriter::Write(const std::string& path) const {
+    std::vector<GlyphArchiveEntry> entries = m_Entries;
+    std::sort(entries.begin(), entries.end(),
+              [](const GlyphArchiveEntry& a, const GlyphArchiveEntry& b) { return a.codepoint < b.codepoint; });
+
+    uint32_t dataStart = (uint32_t)(sizeof(ArchiveHeader) + entries.size() * sizeof(GlyphArchiveEntry));
+    for (auto& e : entries) e.dataOffset += dataStart;
+
+    ArchiveHeader header{};
+    std::memcpy(header.magic, kMagic, 4);
+    header.version = kVersion;
+    header.glyphCount = (uint32_t)entries.size();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write((const char*)&header, sizeof(header));
+    file.write((const char*)entries.data(), entries.size() * sizeof(GlyphArchiveEntry));
+    file.write((const char*)m_Data.data(), m_Data.size());
+    return (bool)file;
+}
+
+// --------------------------------------------------------
+// READER
+// --------------------------------------------------------
+bool GlyphArchive::Load(const std::string& path) {
+    m_File.clear();
+    m_Entries.clear();
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (size < (std::streamsize)sizeof(ArchiveHeader)) return false;
+
+    m_File.resize(size);
+    if (!file.read((char*)m_File.data(), size)) return false;
+
+    ArchiveHeader header;
+    std::memcpy(&header, m_File.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, 4) != 0 || header.version != kVersion) return false;
+
+    size_t tableEnd = sizeof(ArchiveHeader) + (size_t)header.glyphCount * sizeof(GlyphArchiveEntry);
+    if (tableEnd > m_File.size()) return false;
+
+    m_Entries.resize(header.glyphCount);
+    std::memcpy(m_Entries.data(), m_File.data() + sizeof(ArchiveHeader), header.glyphCount * sizeof(GlyphArchiveEntry));
+
+    // Every blob must lie inside the file and hold its vertex streams. The
+    // index stream is checked by DecodeGlyph as it goes, so it is read once.
+    for (const auto& e : m_Entries) {
+        if (e.dataOffset % 4 != 0) return false;
+        if ((uint64_t)e.dataOffset + e.dataSize > m_File.size()) return false;
+        if ((uint64_t)e.vertexCount * 8 > e.dataSize) return false;
+    }
+
+    std::sort(m_Entries.begin(), m_Entries.end(),
+              [](const GlyphArchiveEntry& a, const GlyphArchiveEntry& b) { return a.codepoint < b.codepoint; });
+    return true;
+}
+
+const GlyphArchiveEntry* GlyphArchive::Find(uint32_t codepoint) const {
+    auto it = std::lower_bound(m_Entries.begin(), m_Entries.end(), codepoint,
+                               [](const GlyphArchiveEntry& e, uint32_t cp) { return e.codepoint < cp; });
+    if (it == m_Entries.end() || it->codepoint != codepoint) return nullptr;
+    return &(*it);
+}
+
+bool GlyphArchive::Decode(const GlyphArchiveEntry& e, float* vertexOut, uint32_t* indexOut) const {
+    return DecodeGlyph(e, m_File.data() + e.dataOffset, vertexOut, indexOut);
+}
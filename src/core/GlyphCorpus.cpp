@@ -0,0 +1,64 @@
+#include "GlyphCorpus.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+bool TryDecodeUtf8(const std::string& text, size_t& i, uint32_t& codepoint) {
+    unsigned char c = (unsigned char)text[i++];
+    if (c < 0x80) {
+        codepoint = c;
+        return true;
+    }
+
+    // 0xC0/0xC1 could only start overlong forms, 0xF5+ only values past U+10FFFF
+    int extra = (c >= 0xF5) ? -1 : (c >= 0xF0) ? 3 : (c >= 0xE0) ? 2 : (c >= 0xC2) ? 1 : -1;
+    if (extra < 0) return false;
+
+    uint32_t cp = c & (0x3F >> extra);
+    for (int k = 0; k < extra; ++k) {
+        if (i >= text.size()) return false;
+        unsigned char cc = (unsigned char)text[i];
+        if ((cc & 0xC0) != 0x80) return false;     // Not consumed: it may start the next sequence
+        cp = (cp << 6) | (cc & 0x3F);
+        ++i;
+    }
+
+    // Shortest form only, and no surrogates
+    static const uint32_t minimum[4] = { 0, 0x80, 0x800, 0x10000 };
+    if (cp < minimum[extra] || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return false;
+    codepoint = cp;
+    return true;
+}
+
+uint32_t DecodeUtf8(const std::string& text, size_t& i) {
+    uint32_t cp;
+    return TryDecodeUtf8(text, i, cp) ? cp : 0xFFFD;
+}
+
+void GlyphCorpus::AddString(const std::string& utf8) {
+    for (size_t i = 0; i < utf8.size(); ) {
+        uint32_t cp;
+        if (!TryDecodeUtf8(utf8, i, cp)) continue;  // Nothing to mesh for bytes that aren't text
+        if (cp < 0x20 || cp == 0x7F) continue;     // Newlines, tabs, etc. have no glyph
+        m_Codepoints.push_back(cp);
+        m_Dirty = true;
+    }
+}
+
+bool GlyphCorpus::AddFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    AddString(text);
+    return true;
+}
+
+const std::vector<uint32_t>& GlyphCorpus::GetCodepoints() const {
+    if (m_Dirty) {
+        std::sort(m_Codepoints.begin(), m_Codepoints.end());
+        m_Codepoints.erase(std::unique(m_Codepoints.begin(), m_Codepoints.end()), m_Codepoints.end());
+        m_Dirty = false;
+    }
+    return m_Codepoints;
+}
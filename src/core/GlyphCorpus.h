@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Decodes one UTF-8 codepoint starting at 'i' and advances 'i' past it, or
+// past the bad bytes. Returns false on a malformed sequence: a stray or
+// invalid lead byte (0x80-0xC1, 0xF5+), a missing continuation, an overlong
+// form, a surrogate or a value above U+10FFFF.
+bool TryDecodeUtf8(const std::string& text, size_t& i, uint32_t& codepoint);
+
+// Same, with malformed sequences coming out as U+FFFD.
+uint32_t DecodeUtf8(const std::string& text, size_t& i);
+
+// The set of codepoints a known body of text needs. Used to mesh (or bake)
+// exactly those glyphs instead of a fixed range.
+class GlyphCorpus {
+    mutable std::vector<uint32_t> m_Codepoints;     // Sorted and de-duplicated on read
+    mutable bool m_Dirty = false;
+
+public:
+    void AddString(const std::string& utf8);
+    bool AddFile(const std::string& path);  // Whole file as UTF-8 text
+
+    bool IsEmpty() const { return m_Codepoints.empty(); }
+    const std::vector<uint32_t>& GetCodepoints() const;
+};
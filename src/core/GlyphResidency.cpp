@@ -0,0 +1,141 @@
+#include "GlyphResidency.h"
+#include "TextRenderer3D.h"
+
+#include <algorithm>
+
+GlyphResidency& GlyphResidency::Get() {
+    static GlyphResidency instance;
+    return instance;
+}
+
+void GlyphResidency::SetBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Budget = bytes;
+    EnforceBudget();
+}
+
+void GlyphResidency::BeginFrame() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // 1. Victims picked since the last frame (maybe on the loader thread).
+    // On the render thread, between frames, nothing is drawing them; buffers
+    // are shared with the loader's context and the VAO is this context's.
+    for (GlyphMesh* victim : m_Victims) {
+        if (victim->VAO != 0) glDeleteVertexArrays(1, &victim->VAO);
+        glDeleteBuffers(1, &victim->VBO);
+        glDeleteBuffers(1, &victim->EBO);
+        victim->VAO = victim->VBO = victim->EBO = 0;
+        victim->resident = false;
+        victim->evicting = false;
+        m_FrameEvictions++;
+        m_TotalEvictions++;
+    }
+    m_Victims.clear();
+
+    // 2. Roll the counters over
+    m_LastEvictions = m_FrameEvictions;
+    m_LastReuploads = m_FrameReuploads;
+    m_FrameEvictions = 0;
+    m_FrameReuploads = 0;
+    m_Frame++;
+}
+
+GlyphResidency::Stats GlyphResidency::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    Stats s;
+    s.budgetBytes = m_Budget;
+    s.residentBytes = m_ResidentBytes;
+    s.residentGlyphs = m_Lru.size();
+    s.evictions = m_LastEvictions;
+    s.reuploads = m_LastReuploads;
+    s.totalEvictions = m_TotalEvictions;
+    s.totalReuploads = m_TotalReuploads;
+    return s;
+}
+
+void GlyphResidency::OnUploaded(GlyphMesh& mesh, unsigned int vbo, unsigned int ebo, size_t gpuBytes, bool reupload) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (mesh.resident && !mesh.evicting) {
+        m_ResidentBytes -= mesh.gpuBytes;
+        m_Lru.erase(mesh.lruPos);
+    }
+
+    mesh.VBO = vbo;
+    mesh.EBO = ebo;
+    mesh.resident = true;
+    mesh.gpuBytes = gpuBytes;
+    m_Lru.push_front(&mesh);
+    mesh.lruPos = m_Lru.begin();
+    m_ResidentBytes += gpuBytes;
+
+    if (reupload) {
+        m_FrameReuploads++;
+        m_TotalReuploads++;
+    }
+    EnforceBudget();
+}
+
+bool GlyphResidency::OnDrawn(GlyphMesh& mesh) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!mesh.resident) return false;
+    mesh.lastDrawnFrame = m_Frame;
+
+    // Picked but not deleted yet: still usable, so take it back
+    if (mesh.evicting) {
+        mesh.evicting = false;
+        m_Victims.erase(std::find(m_Victims.begin(), m_Victims.end(), &mesh));
+        m_Lru.push_front(&mesh);
+        mesh.lruPos = m_Lru.begin();
+        m_ResidentBytes += mesh.gpuBytes;
+        return true;
+    }
+    if (mesh.lruPos != m_Lru.begin()) m_Lru.splice(m_Lru.begin(), m_Lru, mesh.lruPos);
+    return true;
+}
+
+void GlyphResidency::OnDestroyed(GlyphMesh& mesh) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!mesh.resident) return;
+    if (mesh.evicting) {
+        m_Victims.erase(std::find(m_Victims.begin(), m_Victims.end(), &mesh));
+        mesh.evicting = false;
+    } else {
+        m_ResidentBytes -= mesh.gpuBytes;
+        m_Lru.erase(mesh.lruPos);
+    }
+    mesh.resident = false;
+}
+
+bool GlyphResidency::IsResident(const GlyphMesh& mesh) const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return mesh.resident;
+}
+
+void GlyphResidency::GetBuffers(const GlyphMesh& mesh, unsigned int& vbo, unsigned int& ebo) const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    vbo = mesh.VBO;
+    ebo = mesh.EBO;
+}
+
+void GlyphResidency::SetVertexArray(GlyphMesh& mesh, unsigned int vao) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    mesh.VAO = vao;
+}
+
+void GlyphResidency::EnforceBudget() {
+    if (m_Budget == 0) return;
+
+    while (m_ResidentBytes > m_Budget && !m_Lru.empty()) {
+        GlyphMesh* victim = m_Lru.back();
+
+        // Everything left was drawn this frame: run over budget rather than thrash
+        if (victim->lastDrawnFrame == m_Frame) break;
+
+        // Only marked here: this may be the loader thread, and the render
+        // thread may be about to draw it. BeginFrame does the deleting.
+        victim->evicting = true;
+        m_Victims.push_back(victim);
+        m_ResidentBytes -= victim->gpuBytes;
+        m_Lru.pop_back();
+    }
+}
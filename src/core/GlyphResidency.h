@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <vector>
+
+struct GlyphMesh;
+
+// Tracks the GPU memory of every glyph mesh and keeps it under a budget by
+// evicting the least recently drawn ones. Evicted meshes keep their metrics
+// and a CPU-side source (compressed copy or archive); TextRenderer3D re-uploads
+// them the next time they are drawn.
+//
+// Process-wide, because glyph caches are shared between renderers.
+//
+// Threads: uploads (OnUploaded) may come from the scene loader, so going over
+// budget there only picks victims. The GL objects are deleted in BeginFrame
+// on the render thread, where no draw can be using them; a victim that gets
+// drawn before then is kept. A mesh's GL handles and residency flags are
+// only written under this class's lock, through the calls below.
+class GlyphResidency {
+public:
+    struct Stats {
+        size_t budgetBytes = 0;         // 0 = unlimited
+        size_t residentBytes = 0;
+        size_t residentGlyphs = 0;
+        uint32_t evictions = 0;         // During the last completed frame
+        uint32_t reuploads = 0;
+        uint64_t totalEvictions = 0;
+        uint64_t totalReuploads = 0;
+    };
+
+    using LruList = std::list<GlyphMesh*>;
+
+    static GlyphResidency& Get();
+
+    void SetBudget(size_t bytes);
+    size_t GetBudget() const { return m_Budget; }
+
+    // Frame boundary: glyphs drawn in the current frame are never evicted,
+    // and the per-frame counters roll over here. Call on the render thread:
+    // this is where victims picked since the last call are actually deleted.
+    void BeginFrame();
+    Stats GetStats() const;
+
+    // --- Called by TextRenderer3D ---
+    // Hands over freshly filled buffers (any thread with a shared context)
+    void OnUploaded(GlyphMesh& mesh, unsigned int vbo, unsigned int ebo, size_t gpuBytes, bool reupload);
+    bool OnDrawn(GlyphMesh& mesh);      // False if it was evicted in the meantime
+    void OnDestroyed(GlyphMesh& mesh);
+
+    bool IsResident(const GlyphMesh& mesh) const;
+
+    // Render thread, after OnDrawn: the buffers to build the mesh's VAO from, and the VAO
+    void GetBuffers(const GlyphMesh& mesh, unsigned int& vbo, unsigned int& ebo) const;
+    void SetVertexArray(GlyphMesh& mesh, unsigned int vao);
+
+private:
+    GlyphResidency() = default;
+    void EnforceBudget();               // Picks victims only (m_Mutex held)
+
+    mutable std::mutex m_Mutex;
+    LruList m_Lru;                      // Front = most recently drawn
+    std::vector<GlyphMesh*> m_Victims;  // Out of the LRU, deleted at the next BeginFrame
+    size_t m_Budget = 0;
+    size_t m_ResidentBytes = 0;
+    uint64_t m_Frame = 1;
+
+    uint32_t m_FrameEvictions = 0, m_FrameReuploads = 0;
+    uint32_t m_LastEvictions = 0, m_LastReuploads = 0;
+    uint64_t m_TotalEvictions = 0, m_TotalReuploads = 0;
+};
@@ -0,0 +1,200 @@
+// stb_truetype's implementation lives in this TU. The header pulls in
+// stb_truetype.h, so the define has to come first.
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "GlyphTessellator.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "../libs/earcut.hpp"
+
+// Define the point type for Earcut (Must happen before usage)
+namespace mapbox {
+namespace util {
+template <> struct nth<0, std::array<double, 2>> {
+    inline static double get(const std::array<double, 2> &t) { return t[0]; };
+};
+template <> struct nth<1, std::array<double, 2>> {
+    inline static double get(const std::array<double, 2> &t) { return t[1]; };
+};
+}
+}
+
+// --------------------------------------------------------
+// HELPER: Add Point (Fixing the brace initialization error)
+// --------------------------------------------------------
+void AddPoint(std::vector<GlyphPoint>& poly, float x, float y) {
+    if (poly.empty()) {
+        poly.push_back(GlyphPoint{(double)x, (double)y});
+        return;
+    }
+    // Check duplicates
+    GlyphPoint& last = poly.back();
+    if (std::abs(last[0] - x) > 0.001 || std::abs(last[1] - y) > 0.001) {
+        poly.push_back(GlyphPoint{(double)x, (double)y});
+    }
+}
+
+void FlattenCurve(std::vector<GlyphPoint>& poly, float x1, float y1, float cx, float cy, float x2, float y2, int depth) {
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    float d = std::abs((cx - x2) * dy - (cy - y2) * dx);
+
+    if (d < 0.5f || depth > 5) {
+        AddPoint(poly, x2, y2);
+        return;
+    }
+
+    float x12 = (x1 + cx) / 2;
+    float y12 = (y1 + cy) / 2;
+    float x23 = (cx + x2) / 2;
+    float y23 = (cy + y2) / 2;
+    float x123 = (x12 + x23) / 2;
+    float y123 = (y12 + y23) / 2;
+
+    FlattenCurve(poly, x1, y1, x12, y12, x123, y123, depth + 1);
+    FlattenCurve(poly, x123, y123, x23, y23, x2, y2, depth + 1);
+}
+
+// --------------------------------------------------------
+// OUTLINE EXTRACTION
+// --------------------------------------------------------
+bool ExtractGlyphOutline(const stbtt_fontinfo* info, int glyphIndex, GlyphPolygon& polygon) {
+    polygon.clear();
+    if (glyphIndex == 0) return false;
+
+    stbtt_vertex* verts;
+    int numVerts = stbtt_GetGlyphShape(info, glyphIndex, &verts);
+
+    float startX = 0, startY = 0;
+    float curX = 0, curY = 0;
+
+    for (int i = 0; i < numVerts; ++i) {
+        if (verts[i].type == STBTT_vmove) {
+            polygon.push_back(std::vector<GlyphPoint>());
+            startX = verts[i].x; startY = verts[i].y;
+            curX = startX; curY = startY;
+            AddPoint(polygon.back(), curX, curY);
+        }
+        else if (verts[i].type == STBTT_vline) {
+            curX = verts[i].x; curY = verts[i].y;
+            AddPoint(polygon.back(), curX, curY);
+        }
+        else if (verts[i].type == STBTT_vcurve) {
+            FlattenCurve(polygon.back(), curX, curY, verts[i].cx, verts[i].cy, verts[i].x, verts[i].y);
+            curX = verts[i].x; curY = verts[i].y;
+        }
+    }
+    stbtt_FreeShape(info, verts);
+
+    return !polygon.empty();
+}
+
+// --------------------------------------------------------
+// MESH GENERATION
+// --------------------------------------------------------
+std::vector<uint32_t> TriangulateGlyphOutline(const GlyphPolygon& polygon) {
+    return mapbox::earcut<uint32_t>(polygon);
+}
+
+void AppendGlyphSideWalls(const GlyphPolygon& polygon, uint32_t backBase, std::vector<uint32_t>& indices) {
+    // Note: For perfect flat shading we should duplicate verts here with new normals.
+    // For now, we connect existing verts. This creates "smooth" looking corners.
+    // Since we use flat color shader, it's acceptable.
+    int ringOffset = 0;
+
+    for (const auto& ring : polygon) {
+        int ringSize = ring.size();
+        for (int i = 0; i < ringSize; ++i) {
+            int current = ringOffset + i;
+            int next = ringOffset + ((i + 1) % ringSize);
+
+            int currentBack = backBase + current;
+            int nextBack = backBase + next;
+
+            indices.push_back(current);
+            indices.push_back(next);
+            indices.push_back(currentBack);
+
+            indices.push_back(next);
+            indices.push_back(nextBack);
+            indices.push_back(currentBack);
+        }
+        ringOffset += ringSize;
+    }
+}
+
+void BuildGlyphGeometry(const GlyphPolygon& polygon, GlyphGeometry& out) {
+    out.vertices.clear();
+    out.indices.clear();
+
+    // 1. Triangulate Front Face
+    std::vector<uint32_t> indices = TriangulateGlyphOutline(polygon);
+
+    // 2. Build 3D Mesh Data
+    std::vector<float>& meshData = out.vertices;
+
+    auto addVert = [&](float x, float y, float z, float nx, float ny, float nz) {
+        meshData.push_back(x); meshData.push_back(y); meshData.push_back(z);
+        meshData.push_back(nx); meshData.push_back(ny); meshData.push_back(nz);
+    };
+
+    // -- FRONT FACE (Z = 0) --
+    for (const auto& ring : polygon) {
+        for (const auto& p : ring) {
+            addVert((float)p[0], (float)p[1], 0.0f, 0, 0, 1);
+        }
+    }
+
+    // -- BACK FACE (Z = -1) --
+    int baseBack = meshData.size() / 6;
+    for (const auto& ring : polygon) {
+        for (const auto& p : ring) {
+            addVert((float)p[0], (float)p[1], -1.0f, 0, 0, -1);
+        }
+    }
+
+    std::vector<uint32_t>& finalIndices = out.indices;
+    finalIndices = indices;
+
+    // Reverse Back Face indices
+    for(size_t i = 0; i < indices.size(); i+=3) {
+        finalIndices.push_back(baseBack + indices[i]);
+        finalIndices.push_back(baseBack + indices[i+2]);
+        finalIndices.push_back(baseBack + indices[i+1]);
+    }
+
+    // -- SIDES --
+    AppendGlyphSideWalls(polygon, baseBack, finalIndices);
+
+    // Bounds of the flattened outline
+    out.minX = out.minY = 0.0f;
+    out.maxX = out.maxY = 0.0f;
+    bool first = true;
+    for (const auto& ring : polygon) {
+        for (const auto& p : ring) {
+            float px = (float)p[0], py = (float)p[1];
+            if (first) { out.minX = out.maxX = px; out.minY = out.maxY = py; first = false; continue; }
+            out.minX = std::min(out.minX, px); out.maxX = std::max(out.maxX, px);
+            out.minY = std::min(out.minY, py); out.maxY = std::max(out.maxY, py);
+        }
+    }
+}
+
+bool TessellateGlyph(const stbtt_fontinfo* info, int glyphIndex, GlyphGeometry& out) {
+    int advWidth = 0, lsb = 0;
+    stbtt_GetGlyphHMetrics(info, glyphIndex, &advWidth, &lsb);
+    out.advance = (float)advWidth;
+
+    GlyphPolygon polygon;
+    if (!ExtractGlyphOutline(info, glyphIndex, polygon)) {
+        // Blank glyph (e.g. space): metrics only
+        out.vertices.clear();
+        out.indices.clear();
+        out.minX = out.minY = out.maxX = out.maxY = 0.0f;
+        return false;
+    }
+
+    BuildGlyphGeometry(polygon, out);
+    return true;
+}
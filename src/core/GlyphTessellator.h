@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "../libs/stb_truetype.h"
+
+// CPU side of one extruded glyph. No GL in here, so the baking tool and
+// benchmarks can use it without a context.
+struct GlyphGeometry {
+    std::vector<float> vertices;    // Interleaved: pos.xyz, normal.xyz (6 floats)
+    std::vector<uint32_t> indices;  // Triangle list
+    float advance = 0.0f;
+    float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+};
+
+using GlyphPoint = std::array<double, 2>;
+using GlyphPolygon = std::vector<std::vector<GlyphPoint>>;
+
+// --- PIPELINE STAGES ---
+void AddPoint(std::vector<GlyphPoint>& poly, float x, float y);
+void FlattenCurve(std::vector<GlyphPoint>& poly, float x1, float y1, float cx, float cy, float x2, float y2, int depth = 0);
+
+// Outline extraction (stbtt_GetGlyphShape + flattening). Returns false for empty glyphs.
+bool ExtractGlyphOutline(const stbtt_fontinfo* info, int glyphIndex, GlyphPolygon& polygon);
+
+// Front face triangles (earcut). Indices count the rings' points in order.
+std::vector<uint32_t> TriangulateGlyphOutline(const GlyphPolygon& polygon);
+
+// Two triangles per outline edge, joining front point i to its back copy at backBase + i.
+void AppendGlyphSideWalls(const GlyphPolygon& polygon, uint32_t backBase, std::vector<uint32_t>& indices);
+
+// Front/back faces (earcut) plus side walls, extruded from Z = 0 to Z = -1.
+void BuildGlyphGeometry(const GlyphPolygon& polygon, GlyphGeometry& out);
+
+// Full pipeline for one glyph, including metrics. Returns false if the glyph has no outline.
+bool TessellateGlyph(const stbtt_fontinfo* info, int glyphIndex, GlyphGeometry& out);
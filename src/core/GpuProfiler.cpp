@@ -0,0 +1,134 @@
+#include "GpuProfiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+// Re-sync the GPU and CPU clocks every so often (they drift apart slowly)
+const int CALIBRATION_INTERVAL = 600;
+// Frames still waiting for results before we stop recording new ones
+const size_t MAX_PENDING_FRAMES = 8;
+
+float Percentile(std::vector<float> v, float p) {
+    if (v.empty()) return 0.0f;
+    size_t i = std::min(v.size() - 1, (size_t)(p * (v.size() - 1) + 0.5f));
+    std::nth_element(v.begin(), v.begin() + i, v.end());
+    return v[i];
+}
+}
+
+GpuProfiler& GpuProfiler::Get() {
+    static GpuProfiler instance;
+    return instance;
+}
+
+void GpuProfiler::BeginFrame(const char* scene) {
+    // 1. Results that have landed
+    Collect(false);
+
+    // 2. The new frame (unless recording is off, or the GPU is hopelessly behind)
+    m_Recording = Profiler::IsEnabled() && m_Frames.size() < MAX_PENDING_FRAMES;
+    if (!m_Recording) return;
+
+    if (!m_Track) {
+        m_Track = Profiler::CreateTrack("GPU");
+        Calibrate();
+    }
+    if (++m_FramesSinceCalibration >= CALIBRATION_INTERVAL) Calibrate();
+
+    m_Frames.push_back({ scene, {} });
+    m_Open.clear();
+}
+
+void GpuProfiler::Begin(const char* name) {
+    Frame& frame = m_Frames.back();
+    Zone zone = { name, AcquireQuery(), 0 };
+    glQueryCounter(zone.begin, GL_TIMESTAMP);
+    m_Open.push_back(frame.zones.size());
+    frame.zones.push_back(zone);
+}
+
+void GpuProfiler::End() {
+    Zone& zone = m_Frames.back().zones[m_Open.back()];
+    m_Open.pop_back();
+    zone.end = AcquireQuery();
+    glQueryCounter(zone.end, GL_TIMESTAMP);
+}
+
+void GpuProfiler::Flush() {
+    m_Recording = false;
+    Collect(true);
+}
+
+void GpuProfiler::Release() {
+    Flush();
+    if (!m_FreeQueries.empty()) glDeleteQueries((GLsizei)m_FreeQueries.size(), m_FreeQueries.data());
+    m_FreeQueries.clear();
+}
+
+GLuint GpuProfiler::AcquireQuery() {
+    if (m_FreeQueries.empty()) {
+        GLuint q[16];
+        glGenQueries(16, q);
+        m_FreeQueries.insert(m_FreeQueries.end(), q, q + 16);
+    }
+    GLuint q = m_FreeQueries.back();
+    m_FreeQueries.pop_back();
+    return q;
+}
+
+void GpuProfiler::Calibrate() {
+    // Both clocks read back to back
+    GLint64 gpuNs = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNs);
+    m_GpuToCpu = (int64_t)Profiler::Now() - gpuNs;
+    m_FramesSinceCalibration = 0;
+}
+
+bool GpuProfiler::Collect(bool wait) {
+    // Frames finish in order; the one being recorded is never collected unless we wait
+    size_t ready = wait ? m_Frames.size() : (m_Frames.empty() ? 0 : m_Frames.size() - 1);
+    while (ready > 0) {
+        Frame& frame = m_Frames.front();
+
+        // The last query issued in a frame is the last one to finish
+        if (!wait && !frame.zones.empty()) {
+            GLint available = 0;
+            glGetQueryObjectiv(frame.zones.back().end, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) return false;
+        }
+
+        for (const Zone& zone : frame.zones) {
+            if (zone.end == 0) {                // Never closed: nothing to report
+                m_FreeQueries.push_back(zone.begin);
+                continue;
+            }
+            GLuint64 begin = 0, end = 0;
+            glGetQueryObjectui64v(zone.begin, GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(zone.end, GL_QUERY_RESULT, &end);
+            m_FreeQueries.push_back(zone.begin);
+            m_FreeQueries.push_back(zone.end);
+
+            Profiler::Record(m_Track, zone.name, begin + m_GpuToCpu, end + m_GpuToCpu);
+            m_Passes[frame.scene][zone.name].push_back((float)((end - begin) * 1e-6));
+        }
+
+        m_Frames.pop_front();
+        ready--;
+    }
+    return true;
+}
+
+void GpuProfiler::PrintReport() const {
+    if (m_Passes.empty()) return;
+
+    printf("\nGPU time per pass (ms)\n");
+    printf("  %-28s %-20s %8s | %7s %7s %7s\n", "scene", "pass", "frames", "p50", "p90", "p99");
+    for (const auto& scene : m_Passes) {
+        for (const auto& pass : scene.second) {
+            const std::vector<float>& s = pass.second;
+            printf("  %-28s %-20s %8zu | %7.3f %7.3f %7.3f\n", scene.first.c_str(), pass.first.c_str(), s.size(),
+                   Percentile(s, 0.5f), Percentile(s, 0.9f), Percentile(s, 0.99f));
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include <GL/glew.h>
+#include "Profiler.h"
+
+struct ProfilerTrack;
+
+// GPU time per render pass.
+//
+//   GPU_ZONE("Text");                // Until the end of the enclosing scope
+//
+// Each zone puts a GL_TIMESTAMP query at its start and end (timestamps,
+// unlike GL_TIME_ELAPSED, may nest). Results are read back a few frames
+// later, only once the GPU has them, so the pipeline never stalls. They go
+// to a "GPU" track in the CPU profiler's trace (same clock) and into
+// per-scene, per-pass statistics printed by PrintReport().
+//
+// Records while the CPU profiler does (--profile / F9). Render thread only.
+class GpuProfiler {
+public:
+    static GpuProfiler& Get();
+
+    // Frame boundary on the render thread: reads back finished frames and
+    // opens a new one attributed to 'scene'
+    void BeginFrame(const char* scene);
+
+    // Blocks until every pending result is in (shutdown, headless runs)
+    void Flush();
+    void Release();
+
+    bool IsRecording() const { return m_Recording; }
+
+    // Zones; 'name' must outlive the profiler (string literals)
+    void Begin(const char* name);
+    void End();
+
+    void PrintReport() const;
+
+private:
+    struct Zone {
+        const char* name;
+        GLuint begin, end;
+    };
+
+    struct Frame {
+        std::string scene;
+        std::vector<Zone> zones;
+    };
+
+    GLuint AcquireQuery();
+    void Calibrate();
+    bool Collect(bool wait);        // Returns false if the oldest frame isn't ready
+
+    std::deque<Frame> m_Frames;     // Oldest first; back() is the one being recorded
+    std::vector<size_t> m_Open;     // Indices of unfinished zones in m_Frames.back()
+    std::vector<GLuint> m_FreeQueries;
+    std::map<std::string, std::map<std::string, std::vector<float>>> m_Passes;    // scene -> pass -> ms
+
+    ProfilerTrack* m_Track = nullptr;
+    int64_t m_GpuToCpu = 0;         // ns to add to a GL timestamp to get Profiler::Now()
+    int m_FramesSinceCalibration = 0;
+    bool m_Recording = false;
+};
+
+class GpuZone {
+    bool m_Active;
+
+public:
+    explicit GpuZone(const char* name) : m_Active(GpuProfiler::Get().IsRecording()) {
+        if (m_Active) GpuProfiler::Get().Begin(name);
+    }
+    ~GpuZone() {
+        if (m_Active) GpuProfiler::Get().End();
+    }
+    GpuZone(const GpuZone&) = delete;
+    GpuZone& operator=(const GpuZone&) = delete;
+};
+
+#ifdef GRAPHICSLAB_PROFILER
+#define GPU_ZONE(name) GpuZone PROFILE_CONCAT(gpuZone_, __LINE__)(name)
+#else
+#define GPU_ZONE(name) ((void)0)
+#endif
@@ -0,0 +1,154 @@
+#include "HeadlessContext.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+#ifdef GRAPHICSLAB_HAS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+HeadlessContext::~HeadlessContext() {
+    Destroy();
+}
+
+#ifdef GRAPHICSLAB_HAS_EGL
+namespace {
+EGLDisplay OpenDisplay() {
+    // 1. Surfaceless platform: needs neither X11 nor a DRM device
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay) {
+        EGLDisplay d = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+        if (d != EGL_NO_DISPLAY && eglInitialize(d, NULL, NULL)) return d;
+    }
+
+    // 2. Whatever the default display is
+    EGLDisplay d = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (d != EGL_NO_DISPLAY && eglInitialize(d, NULL, NULL)) return d;
+    return EGL_NO_DISPLAY;
+}
+}
+
+bool HeadlessContext::Create(int width, int height) {
+    // 1. Display + GL 3.3 core context, current without any surface
+    EGLDisplay display = OpenDisplay();
+    if (display == EGL_NO_DISPLAY) {
+        std::cerr << "Headless: no EGL display" << std::endl;
+        return false;
+    }
+    eglBindAPI(EGL_OPENGL_API);
+
+    EGLint configAttribs[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    EGLConfig config = NULL;
+    EGLint configCount = 0;
+    eglChooseConfig(display, configAttribs, &config, 1, &configCount);
+    if (configCount == 0) config = EGL_NO_CONFIG_KHR;   // Surfaceless may have none: no_config_context
+
+    EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        std::cerr << "Headless: could not create a GL 3.3 core context (EGL error 0x"
+                  << std::hex << eglGetError() << std::dec << ")" << std::endl;
+        if (context != EGL_NO_CONTEXT) eglDestroyContext(display, context);
+        eglTerminate(display);
+        return false;
+    }
+    m_Display = display;
+    m_Context = context;
+
+    // 2. GLEW. Built for GLX, it loads the GL entry points fine but then
+    // reports that there is no GLX display, which is expected here.
+    glewExperimental = GL_TRUE;
+    GLenum glewStatus = glewInit();
+    if (glewStatus != GLEW_OK && glewStatus != GLEW_ERROR_NO_GLX_DISPLAY) {
+        std::cerr << "Headless: failed to initialize GLEW" << std::endl;
+        Destroy();
+        return false;
+    }
+
+    // 3. The framebuffer scenes will draw into
+    m_Width = width;
+    m_Height = height;
+
+    glGenRenderbuffers(1, &m_Color);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_Color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glGenRenderbuffers(1, &m_Depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_Depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+
+    glGenFramebuffers(1, &m_Framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_Color);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_Depth);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Headless: framebuffer incomplete" << std::endl;
+        Destroy();
+        return false;
+    }
+    glViewport(0, 0, width, height);
+
+    std::cout << "Headless: " << glGetString(GL_RENDERER) << ", OpenGL " << glGetString(GL_VERSION)
+              << ", " << width << "x" << height << std::endl;
+    return true;
+}
+
+void HeadlessContext::Destroy() {
+    if (!m_Context) return;
+
+    glDeleteFramebuffers(1, &m_Framebuffer);
+    glDeleteRenderbuffers(1, &m_Color);
+    glDeleteRenderbuffers(1, &m_Depth);
+    m_Framebuffer = m_Color = m_Depth = 0;
+
+    EGLDisplay display = (EGLDisplay)m_Display;
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display, (EGLContext)m_Context);
+    eglTerminate(display);
+    m_Display = m_Context = nullptr;
+}
+#else
+bool HeadlessContext::Create(int width, int height) {
+    std::cerr << "Headless: this build has no EGL support" << std::endl;
+    return false;
+}
+
+void HeadlessContext::Destroy() {}
+#endif
+
+bool HeadlessContext::ReadPixels(std::vector<uint8_t>& rgb) const {
+    if (!m_Context) return false;
+
+    std::vector<uint8_t> bottomUp((size_t)m_Width * m_Height * 3);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_Framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, m_Width, m_Height, GL_RGB, GL_UNSIGNED_BYTE, bottomUp.data());
+
+    // GL rows start at the bottom
+    size_t row = (size_t)m_Width * 3;
+    rgb.resize(bottomUp.size());
+    for (int y = 0; y < m_Height; y++) {
+        std::copy_n(&bottomUp[(size_t)(m_Height - 1 - y) * row], row, &rgb[(size_t)y * row]);
+    }
+    return true;
+}
+
+bool HeadlessContext::WritePPM(const std::string& path) const {
+    std::vector<uint8_t> rgb;
+    if (!ReadPixels(rgb)) return false;
+
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    fprintf(f, "P6\n%d %d\n255\n", m_Width, m_Height);
+    bool ok = fwrite(rgb.data(), 1, rgb.size(), f) == rgb.size();
+    fclose(f);
+    return ok;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <GL/glew.h>
+
+// Windowless GL 3.3 core context for machines with no display and no GPU
+// (EGL on Mesa's surfaceless platform, which falls back to llvmpipe).
+// Renders into its own FBO, which stays bound, so scenes run unmodified:
+// they only ever draw to "the current framebuffer".
+//
+// Only available when built with EGL (GRAPHICSLAB_HAS_EGL); Create() fails otherwise.
+class HeadlessContext {
+public:
+    ~HeadlessContext();
+
+    bool Create(int width, int height);
+    void Destroy();
+
+    int GetWidth() const { return m_Width; }
+    int GetHeight() const { return m_Height; }
+
+    // Top-down RGB rows
+    bool ReadPixels(std::vector<uint8_t>& rgb) const;
+    bool WritePPM(const std::string& path) const;
+
+private:
+    void* m_Display = nullptr;          // EGLDisplay / EGLContext, kept opaque so
+    void* m_Context = nullptr;          // this header doesn't pull in EGL
+    GLuint m_Framebuffer = 0;
+    GLuint m_Color = 0, m_Depth = 0;
+    int m_Width = 0, m_Height = 0;
+};
@@ -0,0 +1,147 @@
+#include "Input.h"
+#include "LatencyTracker.h"
+#include "InputRecording.h"
+
+void InputSystem::Install(GLFWwindow* window) {
+    glfwSetWindowUserPointer(window, this);
+    glfwSetKeyCallback(window, KeyCallback);
+    glfwSetMouseButtonCallback(window, MouseButtonCallback);
+    glfwSetCursorPosCallback(window, CursorPosCallback);
+    glfwSetWindowSizeCallback(window, WindowSizeCallback);
+
+    // Starting state, as events
+    int w, h;
+    glfwGetWindowSize(window, &w, &h);
+    InputEvent size;
+    size.type = InputEvent::WindowSize;
+    size.x = w;
+    size.y = h;
+    size.time = glfwGetTime();
+    Push(size);
+
+    double cx, cy;
+    glfwGetCursorPos(window, &cx, &cy);
+    InputEvent cursor;
+    cursor.type = InputEvent::CursorMove;
+    cursor.x = cx;
+    cursor.y = cy;
+    cursor.time = glfwGetTime();
+    Push(cursor);
+}
+
+void InputSystem::Push(const InputEvent& event) {
+    if (!m_Queue.Push(event)) m_Dropped++;
+}
+
+const InputSnapshot& InputSystem::BeginStep(float dt) {
+    // 1. Edges only last one step
+    for (uint8_t& k : m_Snapshot.keys) k &= InputSnapshot::DOWN;
+    for (uint8_t& b : m_Snapshot.buttons) b &= InputSnapshot::DOWN;
+
+    // 2. Everything that happened since the last step
+    InputEvent event;
+    m_Snapshot.eventCount = 0;
+    while (m_Queue.Pop(event)) {
+        if (m_Replay) continue;     // Only the recording drives a replay
+        Apply(event);
+        m_Snapshot.eventCount++;
+        if (m_Latency && event.type != InputEvent::WindowSize) m_Latency->OnInputConsumed(event.time);
+        if (m_Recording) m_Recording->Add(m_Step, event);
+    }
+
+    // 3. Or what the recording applied in this step (never arrived live: no latency to report)
+    if (m_Replay) {
+        const std::vector<InputRecording::Entry>& entries = m_Replay->GetEntries();
+        for (; m_ReplayCursor < entries.size() && entries[m_ReplayCursor].step == m_Step; m_ReplayCursor++) {
+            Apply(entries[m_ReplayCursor].event);
+            m_Snapshot.eventCount++;
+        }
+    }
+
+    m_Step++;
+    if (m_Recording) m_Recording->SetStepCount(m_Step);
+    m_Snapshot.time += dt;
+    return m_Snapshot;
+}
+
+void InputSystem::StartRecording(InputRecording* recording) {
+    m_Recording = recording;
+    m_Step = 0;
+}
+
+void InputSystem::StartReplay(const InputRecording* recording) {
+    m_Replay = recording;
+    m_ReplayCursor = 0;
+    m_Step = 0;
+}
+
+void InputSystem::Apply(const InputEvent& e) {
+    switch (e.type) {
+    case InputEvent::Key:
+    case InputEvent::MouseButton: {
+        uint8_t* states = e.type == InputEvent::Key ? m_Snapshot.keys : m_Snapshot.buttons;
+        int count = e.type == InputEvent::Key ? InputSnapshot::KEY_COUNT : InputSnapshot::BUTTON_COUNT;
+        if (e.code < 0 || e.code >= count) break;
+
+        uint8_t& s = states[e.code];
+        if (e.action == GLFW_PRESS) s |= InputSnapshot::DOWN | InputSnapshot::PRESSED;
+        else if (e.action == GLFW_RELEASE) s = (s & ~InputSnapshot::DOWN) | InputSnapshot::RELEASED;
+        break;
+    }
+    case InputEvent::CursorMove:
+        m_Snapshot.cursorX = e.x;
+        m_Snapshot.cursorY = e.y;
+        break;
+    case InputEvent::WindowSize:
+        m_Snapshot.windowWidth = (int)e.x;
+        m_Snapshot.windowHeight = (int)e.y;
+        break;
+    }
+}
+
+// --------------------------------------------------------
+// GLFW CALLBACKS
+// --------------------------------------------------------
+void InputSystem::KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    InputSystem* self = (InputSystem*)glfwGetWindowUserPointer(window);
+    if (action == GLFW_REPEAT) return;     // Held state is already tracked
+
+    if (self->m_KeyListener) self->m_KeyListener(key, action);
+
+    InputEvent e;
+    e.time = glfwGetTime();
+    e.type = InputEvent::Key;
+    e.code = key;
+    e.action = action;
+    self->Push(e);
+}
+
+void InputSystem::MouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
+    InputSystem* self = (InputSystem*)glfwGetWindowUserPointer(window);
+    InputEvent e;
+    e.time = glfwGetTime();
+    e.type = InputEvent::MouseButton;
+    e.code = button;
+    e.action = action;
+    self->Push(e);
+}
+
+void InputSystem::CursorPosCallback(GLFWwindow* window, double x, double y) {
+    InputSystem* self = (InputSystem*)glfwGetWindowUserPointer(window);
+    InputEvent e;
+    e.time = glfwGetTime();
+    e.type = InputEvent::CursorMove;
+    e.x = x;
+    e.y = y;
+    self->Push(e);
+}
+
+void InputSystem::WindowSizeCallback(GLFWwindow* window, int width, int height) {
+    InputSystem* self = (InputSystem*)glfwGetWindowUserPointer(window);
+    InputEvent e;
+    e.time = glfwGetTime();
+    e.type = InputEvent::WindowSize;
+    e.x = width;
+    e.y = height;
+    self->Push(e);
+}
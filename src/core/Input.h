@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <GLFW/glfw3.h>
+#include "SpscQueue.h"
+
+class LatencyTracker;
+class InputRecording;
+
+// One raw window event, as recorded by the GLFW callbacks.
+// Plain data, so it can be queued between threads and written to disk.
+struct InputEvent {
+    enum Type : uint8_t { Key, MouseButton, CursorMove, WindowSize };
+
+    Type type = Key;
+    int32_t code = 0;           // Key: GLFW_KEY_*, MouseButton: GLFW_MOUSE_BUTTON_*
+    int32_t action = 0;         // GLFW_PRESS / GLFW_RELEASE / GLFW_REPEAT
+    double x = 0.0, y = 0.0;    // CursorMove: window coords (top-left origin), WindowSize: w, h
+    double time = 0.0;          // Arrival, glfwGetTime() in the callback (replays: the simulated clock)
+};
+
+// What OnUpdate sees for one fixed step. Edge flags make taps shorter than a
+// step visible: a key pressed and released in between reports WasPressed()
+// and WasReleased() even though it is no longer down.
+struct InputSnapshot {
+    static constexpr int KEY_COUNT = GLFW_KEY_LAST + 1;
+    static constexpr int BUTTON_COUNT = GLFW_MOUSE_BUTTON_LAST + 1;
+
+    enum : uint8_t { DOWN = 1, PRESSED = 2, RELEASED = 4 };
+
+    uint8_t keys[KEY_COUNT] = {};
+    uint8_t buttons[BUTTON_COUNT] = {};
+    double cursorX = 0.0, cursorY = 0.0;
+    int windowWidth = 0, windowHeight = 0;
+    double time = 0.0;          // Simulation time at the end of this step (seconds)
+    int eventCount = 0;         // Events applied in this step
+
+    bool IsKeyDown(int key) const { return InRange(key, KEY_COUNT) && (keys[key] & DOWN); }
+    bool WasKeyPressed(int key) const { return InRange(key, KEY_COUNT) && (keys[key] & PRESSED); }
+    bool WasKeyReleased(int key) const { return InRange(key, KEY_COUNT) && (keys[key] & RELEASED); }
+    // Down at any point during the step
+    bool IsKeyActive(int key) const { return IsKeyDown(key) || WasKeyPressed(key); }
+
+    bool IsButtonDown(int button) const { return InRange(button, BUTTON_COUNT) && (buttons[button] & DOWN); }
+    bool WasButtonPressed(int button) const { return InRange(button, BUTTON_COUNT) && (buttons[button] & PRESSED); }
+
+private:
+    static bool InRange(int v, int count) { return v >= 0 && v < count; }
+};
+
+// Event-driven input.
+// GLFW callbacks (main thread, inside glfwPollEvents) push InputEvents into a
+// lock-free queue; whichever thread runs OnUpdate calls BeginStep() to drain
+// it into the snapshot. Scenes only ever read the snapshot, so no input is
+// polled per frame and nothing is lost between polls.
+class InputSystem {
+public:
+    using KeyListener = std::function<void(int key, int action)>;
+
+    // Installs the callbacks on 'window' (uses the window user pointer)
+    void Install(GLFWwindow* window);
+
+    // Host hook for keys that never reach scenes' logic (scene hotkeys etc).
+    // Runs on the main thread, inside glfwPollEvents.
+    void SetKeyListener(KeyListener listener) { m_KeyListener = std::move(listener); }
+
+    // Optional: told about every input event as it is applied (--latency)
+    void SetLatencyTracker(LatencyTracker* tracker) { m_Latency = tracker; }
+
+    // --- Record / replay (--record, --replay) ---
+    // Set before the first BeginStep; the recording must outlive the steps.
+    // Recording appends every event BeginStep applies, stamped with its step.
+    void StartRecording(InputRecording* recording);
+    // Replaying, each BeginStep applies the recording's events for that step
+    // instead of live ones, which are drained and dropped: the scene sees
+    // the recorded run's snapshots, step for step.
+    void StartReplay(const InputRecording* recording);
+
+    // --- Producer (main thread) ---
+    void Push(const InputEvent& event);
+
+    // --- Consumer (the update thread) ---
+    // Clears last step's edges, applies everything queued since, advances
+    // the simulation clock by 'dt' and returns the snapshot for this step.
+    const InputSnapshot& BeginStep(float dt);
+    const InputSnapshot& GetSnapshot() const { return m_Snapshot; }
+
+    uint64_t GetDroppedEvents() const { return m_Dropped.load(); }
+
+private:
+    void Apply(const InputEvent& event);
+
+    static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+    static void MouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+    static void CursorPosCallback(GLFWwindow* window, double x, double y);
+    static void WindowSizeCallback(GLFWwindow* window, int width, int height);
+
+    SpscQueue<InputEvent, 1024> m_Queue;
+    std::atomic<uint64_t> m_Dropped{ 0 };
+    InputSnapshot m_Snapshot;
+    KeyListener m_KeyListener;
+    LatencyTracker* m_Latency = nullptr;
+
+    InputRecording* m_Recording = nullptr;
+    const InputRecording* m_Replay = nullptr;
+    size_t m_ReplayCursor = 0;
+    uint32_t m_Step = 0;        // Steps since recording / replay started
+};
@@ -0,0 +1,110 @@
+#include "InputRecording.h"
+
+#include <cstring>
+#include <fstream>
+
+// File layout (host byte order and double format, so not portable between
+// hosts that differ in either; a byte-swapped header fails the version check):
+//   RecordingHeader
+//   RecordedEvent[eventCount], in step order
+// 24 bytes per event. Event times aren't stored: on replay they are the
+// simulated clock, step * stepSeconds.
+namespace {
+
+const char kMagic[4] = { 'G', 'L', 'I', 'N' };
+const uint32_t kVersion = 1;
+
+struct RecordingHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t stepCount;
+    uint32_t eventCount;
+    double stepSeconds;
+};
+
+struct RecordedEvent {
+    uint32_t step;
+    uint8_t type;               // InputEvent::Type
+    uint8_t action;
+    int16_t code;               // GLFW key / button codes all fit
+    double x, y;
+};
+
+static_assert(sizeof(RecordingHeader) == 24, "Recording header must be packed");
+static_assert(sizeof(RecordedEvent) == 24, "Recorded event must be packed");
+}
+
+void InputRecording::Add(uint32_t step, const InputEvent& event) {
+    m_Entries.push_back({ step, event });
+    if (step >= m_StepCount) m_StepCount = step + 1;
+}
+
+bool InputRecording::Save(const std::string& path) const {
+    RecordingHeader header{};
+    std::memcpy(header.magic, kMagic, 4);
+    header.version = kVersion;
+    header.stepCount = m_StepCount;
+    header.eventCount = (uint32_t)m_Entries.size();
+    header.stepSeconds = m_StepSeconds;
+
+    std::vector<RecordedEvent> events(m_Entries.size());
+    for (size_t i = 0; i < m_Entries.size(); i++) {
+        const InputEvent& e = m_Entries[i].event;
+        RecordedEvent& r = events[i];
+        r.step = m_Entries[i].step;
+        r.type = (uint8_t)e.type;
+        r.action = (uint8_t)e.action;
+        r.code = (int16_t)e.code;
+        r.x = e.x;
+        r.y = e.y;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write((const char*)&header, sizeof(header));
+    file.write((const char*)events.data(), events.size() * sizeof(RecordedEvent));
+    return (bool)file;
+}
+
+bool InputRecording::Load(const std::string& path) {
+    m_Entries.clear();
+    m_StepCount = 0;
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (size < (std::streamsize)sizeof(RecordingHeader)) return false;
+
+    RecordingHeader header;
+    if (!file.read((char*)&header, sizeof(header))) return false;
+    if (std::memcmp(header.magic, kMagic, 4) != 0 || header.version != kVersion) return false;
+
+    // The count must describe exactly this file before it sizes an allocation
+    if ((uint64_t)size != sizeof(header) + (uint64_t)header.eventCount * sizeof(RecordedEvent)) return false;
+
+    std::vector<RecordedEvent> events(header.eventCount);
+    if (!file.read((char*)events.data(), events.size() * sizeof(RecordedEvent))) return false;
+
+    // Replay walks the events in order, one step at a time
+    m_Entries.reserve(events.size());
+    uint32_t lastStep = 0;
+    for (const RecordedEvent& r : events) {
+        if (r.step < lastStep || r.step >= header.stepCount || r.type > InputEvent::WindowSize) return false;
+        lastStep = r.step;
+
+        InputEvent e;
+        e.type = (InputEvent::Type)r.type;
+        e.action = r.action;
+        e.code = r.code;
+        e.x = r.x;
+        e.y = r.y;
+        e.time = r.step * header.stepSeconds;
+        m_Entries.push_back({ r.step, e });
+    }
+
+    m_StepSeconds = header.stepSeconds;
+    m_StepCount = header.stepCount;
+    return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Input.h"
+
+// ---------------------------------------------------------------
+// Input recording (.input)
+// ---------------------------------------------------------------
+// The events InputSystem applied, each stamped with the fixed simulation
+// step that consumed it rather than with wall-clock time. Replaying them
+// step by step feeds OnUpdate exactly the snapshots the recorded run saw,
+// however fast or slow the replaying machine renders, so a headless
+// --replay run is bit-identical from one run to the next. Files are in the
+// recording host's byte order: replay them on the same kind of machine.
+class InputRecording {
+public:
+    struct Entry {
+        uint32_t step;              // Steps since the recording started
+        InputEvent event;
+    };
+
+    void SetStepSeconds(double seconds) { m_StepSeconds = seconds; }
+    double GetStepSeconds() const { return m_StepSeconds; }
+
+    // Recording side (the update thread), in step order
+    void Add(uint32_t step, const InputEvent& event);
+    void SetStepCount(uint32_t steps) { m_StepCount = steps; }
+
+    // Length of the recorded run, including steps without events
+    uint32_t GetStepCount() const { return m_StepCount; }
+    const std::vector<Entry>& GetEntries() const { return m_Entries; }
+
+    bool Save(const std::string& path) const;
+    bool Load(const std::string& path);
+
+private:
+    std::vector<Entry> m_Entries;
+    double m_StepSeconds = 0.0;
+    uint32_t m_StepCount = 0;
+};
@@ -0,0 +1,198 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+// Which system's worker this thread is (null for every other thread)
+thread_local const JobSystem* t_Owner = nullptr;
+thread_local int t_QueueIndex = 0;
+}
+
+JobSystem::JobSystem(int workerCount) {
+    if (workerCount < 0) {
+        int hw = (int)std::thread::hardware_concurrency();
+        workerCount = std::max(hw - 1, 1);
+    }
+
+    for (int i = 0; i <= workerCount; i++) m_Queues.push_back(std::make_unique<WorkQueue>());
+    for (int i = 1; i <= workerCount; i++) m_Workers.emplace_back([this, i]() { WorkerLoop(i); });
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_Quit = true;
+    }
+    m_Sleep.notify_all();
+    for (std::thread& t : m_Workers) t.join();
+}
+
+int JobSystem::GetQueueIndex() const {
+    return t_Owner == this ? t_QueueIndex : 0;
+}
+
+// --------------------------------------------------------
+// SUBMISSION
+// --------------------------------------------------------
+void JobSystem::Run(std::function<void()> fn, JobCounter* counter) {
+    if (counter) counter->m_Pending++;
+    Submit({ std::move(fn), counter });
+}
+
+void JobSystem::RunAfter(JobCounter& dependency, std::function<void()> fn, JobCounter* counter) {
+    if (counter) counter->m_Pending++;
+    {
+        // Finish() reaches zero under this lock, so either it sees our
+        // continuation or we see the zero
+        std::lock_guard<std::mutex> lock(dependency.m_Mutex);
+        if (dependency.m_Pending.load() != 0) {
+            dependency.m_Continuations.push_back({ std::move(fn), counter });
+            return;
+        }
+    }
+    Submit({ std::move(fn), counter });
+}
+
+void JobSystem::Submit(Job job) {
+    WorkQueue& q = *m_Queues[GetQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.jobs.push_back(std::move(job));
+    }
+    m_Queued++;
+
+    // Only pay for the wake-up when someone is actually asleep
+    if (m_Sleepers.load() > 0) {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_Sleep.notify_one();
+    }
+}
+
+// --------------------------------------------------------
+// EXECUTION
+// --------------------------------------------------------
+bool JobSystem::TryRunOne(int self) {
+    Job job;
+    bool found = false;
+
+    // 1. Own queue, newest first
+    {
+        WorkQueue& own = *m_Queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            found = true;
+        }
+    }
+
+    // 2. Steal the oldest job from someone else
+    int n = (int)m_Queues.size();
+    for (int k = 1; k < n && !found; k++) {
+        WorkQueue& victim = *m_Queues[(self + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found) return false;
+    m_Queued--;
+
+    // An exception must not skip Finish(): the counter would never reach zero
+    // and Wait() would spin forever. It goes to whoever waits on the counter.
+    std::exception_ptr error;
+    try {
+        job.fn();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    Finish(job.counter, error);
+    return true;
+}
+
+void JobSystem::Finish(JobCounter* counter, std::exception_ptr error) {
+    if (!counter) {
+        // Fire-and-forget: nobody to hand it to
+        if (error) {
+            try {
+                std::rethrow_exception(error);
+            } catch (const std::exception& e) {
+                std::cerr << "JobSystem: job without a counter threw: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "JobSystem: job without a counter threw" << std::endl;
+            }
+        }
+        return;
+    }
+
+    // Decrement under the lock: once Wait() has seen zero and taken the lock
+    // itself, nothing here touches the counter any more and it can be destroyed
+    std::vector<Job> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->m_Mutex);
+        if (error && !counter->m_Error) counter->m_Error = error;
+        if (--counter->m_Pending == 0) ready.swap(counter->m_Continuations);
+    }
+    for (Job& job : ready) Submit(std::move(job));
+}
+
+void JobSystem::WorkerLoop(int index) {
+    t_Owner = this;
+    t_QueueIndex = index;
+    Profiler::SetThreadName(("Job worker " + std::to_string(index)).c_str());
+
+    while (!m_Quit) {
+        if (TryRunOne(index)) continue;
+
+        // Nothing anywhere: spin briefly (new work usually comes in bursts), then sleep
+        bool found = false;
+        for (int spin = 0; spin < 64 && !found; spin++) {
+            std::this_thread::yield();
+            found = m_Queued.load() > 0;
+        }
+        if (found) continue;
+
+        std::unique_lock<std::mutex> lock(m_SleepMutex);
+        m_Sleepers++;
+        m_Sleep.wait(lock, [this]() { return m_Quit || m_Queued.load() > 0; });
+        m_Sleepers--;
+    }
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    int self = GetQueueIndex();
+    while (!counter.IsDone()) {
+        if (!TryRunOne(self)) std::this_thread::yield();
+    }
+
+    // Let the thread that finished the last job release the counter
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(counter.m_Mutex);
+        error.swap(counter.m_Error);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+
+    // Not worth a job
+    if (count <= grain || m_Workers.empty()) {
+        body(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (size_t begin = 0; begin < count; begin += grain) {
+        size_t end = std::min(begin + grain, count);
+        Run([&body, begin, end]() { body(begin, end); }, &counter);
+    }
+    Wait(counter);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobCounter;
+
+struct Job {
+    std::function<void()> fn;
+    JobCounter* counter = nullptr;      // Decremented when fn returns or throws
+};
+
+// Tracks a group of jobs. Wait() on it, or chain more jobs behind it with
+// JobSystem::RunAfter(). Only destroy it after JobSystem::Wait() returned.
+// A job that throws still counts as finished; Wait() rethrows the first
+// exception once the whole group is done.
+class JobCounter {
+    friend class JobSystem;
+    std::atomic<int> m_Pending{ 0 };
+    std::mutex m_Mutex;
+    std::vector<Job> m_Continuations;   // Submitted when m_Pending hits 0
+    std::exception_ptr m_Error;         // First exception a job threw (under m_Mutex)
+
+public:
+    bool IsDone() const { return m_Pending.load() == 0; }
+};
+
+// Work-stealing scheduler.
+// Each worker owns a deque: it pushes and pops its own jobs at the back
+// (newest first, cache-warm), and idle workers steal from the front of the
+// others (oldest first, usually the biggest chunks). Threads that aren't
+// workers (main, loader, sim) submit into a shared queue, and any thread
+// blocked in Wait() runs jobs instead of sleeping.
+class JobSystem {
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> m_Queues;   // 0 = external threads, 1..N = workers
+    std::vector<std::thread> m_Workers;
+
+    std::atomic<int> m_Queued{ 0 };
+    std::atomic<int> m_Sleepers{ 0 };
+    std::atomic<bool> m_Quit{ false };
+    std::mutex m_SleepMutex;
+    std::condition_variable m_Sleep;
+
+    int GetQueueIndex() const;
+    void Submit(Job job);
+    bool TryRunOne(int self);
+    void Finish(JobCounter* counter, std::exception_ptr error);
+    void WorkerLoop(int index);
+
+public:
+    // -1: one worker per hardware thread, minus the main thread
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    int GetWorkerCount() const { return (int)m_Workers.size(); }
+
+    void Run(std::function<void()> fn, JobCounter* counter = nullptr);
+
+    // Queued only once 'dependency' reaches zero (immediately if it already has)
+    void RunAfter(JobCounter& dependency, std::function<void()> fn, JobCounter* counter = nullptr);
+
+    // Runs other jobs on this thread until 'counter' reaches zero, then
+    // rethrows the first exception one of its jobs threw, if any
+    void Wait(JobCounter& counter);
+
+    // Splits [0, count) into chunks of about 'grain' and calls body(begin, end)
+    // for each, spread over the workers and the calling thread. Blocks until
+    // done; rethrows if a chunk threw.
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+};
@@ -0,0 +1,110 @@
+#include "LatencyTracker.h"
+
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+// Re-sync the GPU and CPU clocks every so often (they drift apart slowly)
+const int CALIBRATION_INTERVAL = 600;
+
+float Percentile(std::vector<float> v, float p) {
+    if (v.empty()) return 0.0f;
+    size_t i = std::min(v.size() - 1, (size_t)(p * (v.size() - 1) + 0.5f));
+    std::nth_element(v.begin(), v.begin() + i, v.end());
+    return v[i];
+}
+}
+
+void LatencyTracker::Init() {
+    m_Enabled = true;
+    Calibrate();
+}
+
+void LatencyTracker::Release() {
+    for (const PendingFrame& f : m_Pending) m_FreeQueries.push_back(f.query);
+    m_Pending.clear();
+    if (!m_FreeQueries.empty()) glDeleteQueries((GLsizei)m_FreeQueries.size(), m_FreeQueries.data());
+    m_FreeQueries.clear();
+}
+
+void LatencyTracker::Calibrate() {
+    // Both clocks read back to back; the GL one is the GPU's "now" in ns
+    GLint64 gpuNs = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNs);
+    double cpu = glfwGetTime();
+    m_GpuToCpu = cpu - gpuNs * 1e-9;
+    m_FramesSinceCalibration = 0;
+}
+
+void LatencyTracker::OnInputConsumed(double arrivalTime) {
+    if (!m_Enabled) return;
+    std::lock_guard<std::mutex> lock(m_ConsumedMutex);
+    m_Consumed.push_back(arrivalTime);
+}
+
+void LatencyTracker::OnFrameSwapped(const char* scene, double swapTime) {
+    if (!m_Enabled) return;
+
+    PendingFrame frame;
+    {
+        std::lock_guard<std::mutex> lock(m_ConsumedMutex);
+        frame.arrivals.swap(m_Consumed);
+    }
+
+    // Frames that show no new input cost nothing beyond this
+    if (!frame.arrivals.empty()) {
+        if (m_FreeQueries.empty()) {
+            GLuint q;
+            glGenQueries(1, &q);
+            m_FreeQueries.push_back(q);
+        }
+        frame.query = m_FreeQueries.back();
+        m_FreeQueries.pop_back();
+        glQueryCounter(frame.query, GL_TIMESTAMP);
+
+        frame.scene = scene;
+        frame.swapTime = swapTime;
+        m_Pending.push_back(std::move(frame));
+    }
+
+    Collect();
+    if (++m_FramesSinceCalibration >= CALIBRATION_INTERVAL) Calibrate();
+}
+
+void LatencyTracker::Collect() {
+    // Results come back in order; stop at the first one that isn't ready
+    while (!m_Pending.empty()) {
+        PendingFrame& f = m_Pending.front();
+        GLint available = 0;
+        glGetQueryObjectiv(f.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) break;
+
+        GLuint64 gpuNs = 0;
+        glGetQueryObjectui64v(f.query, GL_QUERY_RESULT, &gpuNs);
+        double gpuDone = gpuNs * 1e-9 + m_GpuToCpu;
+
+        Samples& s = m_Scenes[f.scene];
+        for (double arrival : f.arrivals) {
+            s.toSwap.push_back((float)((f.swapTime - arrival) * 1000.0));
+            s.toGpu.push_back((float)((gpuDone - arrival) * 1000.0));
+        }
+
+        m_FreeQueries.push_back(f.query);
+        m_Pending.pop_front();
+    }
+}
+
+void LatencyTracker::PrintReport() const {
+    if (!m_Enabled) return;
+
+    printf("\nInput-to-photon latency (ms)\n");
+    printf("  %-28s %8s | %7s %7s %7s | %7s %7s %7s\n", "scene", "events",
+           "swap50", "swap90", "swap99", "gpu50", "gpu90", "gpu99");
+    for (const auto& pair : m_Scenes) {
+        const Samples& s = pair.second;
+        printf("  %-28s %8zu | %7.2f %7.2f %7.2f | %7.2f %7.2f %7.2f\n", pair.first.c_str(), s.toSwap.size(),
+               Percentile(s.toSwap, 0.5f), Percentile(s.toSwap, 0.9f), Percentile(s.toSwap, 0.99f),
+               Percentile(s.toGpu, 0.5f), Percentile(s.toGpu, 0.9f), Percentile(s.toGpu, 0.99f));
+    }
+}
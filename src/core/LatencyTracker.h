@@ -0,0 +1,59 @@
+#pragma once
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <GL/glew.h>
+
+// Input-to-photon latency (--latency).
+// Every input event carries its arrival time (glfwGetTime in the GLFW
+// callback). When the update thread applies it, it becomes "consumed"; the
+// next frame swapped after that is the first one that can show it. For that
+// frame we take the swap time, and the GPU completion time from a
+// GL_TIMESTAMP query converted to the CPU clock, and record
+//   arrival -> swap        (CPU side: queueing + update + render + pacing)
+//   arrival -> GPU done    (what actually reached the framebuffer)
+// per scene. The display's own scan-out delay is not visible from here.
+class LatencyTracker {
+public:
+    // Needs the context current
+    void Init();
+    void Release();
+
+    // Update thread (main or sim): an event that arrived at 'arrivalTime' was applied
+    void OnInputConsumed(double arrivalTime);
+
+    // Main thread, right after SwapBuffers
+    void OnFrameSwapped(const char* scene, double swapTime);
+
+    void PrintReport() const;
+
+private:
+    struct PendingFrame {
+        std::string scene;
+        std::vector<double> arrivals;
+        double swapTime;
+        GLuint query;
+    };
+
+    struct Samples {
+        std::vector<float> toSwap;      // ms
+        std::vector<float> toGpu;       // ms
+    };
+
+    void Calibrate();
+    void Collect();                     // Finishes frames whose query result is in
+
+    std::mutex m_ConsumedMutex;
+    std::vector<double> m_Consumed;     // Applied since the last swap
+
+    std::deque<PendingFrame> m_Pending; // Oldest first
+    std::vector<GLuint> m_FreeQueries;
+    std::map<std::string, Samples> m_Scenes;
+
+    double m_GpuToCpu = 0.0;            // Seconds to add to a GPU timestamp
+    int m_FramesSinceCalibration = 0;
+    bool m_Enabled = false;
+};
@@ -0,0 +1,330 @@
+#include "PerfHud.h"
+#include "GLStats.h"
+#include "AllocTracker.h"
+#include "GlyphResidency.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+// Debian/Ubuntu, Fedora, Arch
+const char* DEFAULT_FONTS[] = {
+    "/usr/share/fonts/truetype/dejavu/DejaVuSansMono.ttf",
+    "/usr/share/fonts/dejavu-sans-mono-fonts/DejaVuSansMono.ttf",
+    "/usr/share/fonts/TTF/DejaVuSansMono.ttf",
+};
+
+const char* compositeVert = R"GLSL(
+#version 330 core
+uniform vec4 uRect;         // x, y, w, h in pixels from the top-left
+uniform vec2 uScreen;
+out vec2 vUV;
+void main() {
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    vec2 pos = uRect.xy + corner * uRect.zw;
+    vUV = vec2(corner.x, 1.0 - corner.y);
+    gl_Position = vec4(pos.x / uScreen.x * 2.0 - 1.0, 1.0 - pos.y / uScreen.y * 2.0, 0.0, 1.0);
+}
+)GLSL";
+
+const char* compositeFrag = R"GLSL(
+#version 330 core
+in vec2 vUV;
+uniform sampler2D uPanel;
+out vec4 FragColor;
+void main() {
+    FragColor = texture(uPanel, vUV);
+}
+)GLSL";
+
+GLuint CompileCompositeProgram() {
+    GLuint vs = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vs, 1, &compositeVert, NULL);
+    glCompileShader(vs);
+    GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fs, 1, &compositeFrag, NULL);
+    glCompileShader(fs);
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cerr << "PerfHud: shader error: " << infoLog << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+const float FONT_PX = 16.0f;
+const double REBUILD_MS = 250.0;        // Numbers changing faster than this can't be read anyway
+const float MARGIN = 8.0f;
+const float GRAPH_HEIGHT = 60.0f;
+const float GRAPH_MAX_MS = 33.3f;       // Top of the graph
+const float BAR_WIDTH = 2.0f;
+
+const uint32_t PANEL = 0x000000B0;
+const uint32_t TEXT = 0xFFFFFFFF;
+const uint32_t DIM = 0xA0A0A0FF;
+const uint32_t GOOD = 0x40E040FF;       // Under 60 Hz budget
+const uint32_t SLOW = 0xE0C040FF;       // Under 30 Hz budget
+const uint32_t BAD = 0xE04040FF;
+
+double ToMB(size_t bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+}
+
+// --------------------------------------------------------
+// GPU TIMER
+// --------------------------------------------------------
+void PerfHud::GpuTimer::Begin() {
+    if (!queries[0][0]) glGenQueries(FRAMES * 2, &queries[0][0]);
+
+    // The slot we are about to reuse was issued FRAMES frames ago: read it if it's in
+    if (issued[frame]) {
+        GLint available = 0;
+        glGetQueryObjectiv(queries[frame][1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            GLuint64 t0 = 0, t1 = 0;
+            glGetQueryObjectui64v(queries[frame][0], GL_QUERY_RESULT, &t0);
+            glGetQueryObjectui64v(queries[frame][1], GL_QUERY_RESULT, &t1);
+            lastMs = (t1 - t0) * 1e-6;
+        }
+    }
+    glQueryCounter(queries[frame][0], GL_TIMESTAMP);
+}
+
+void PerfHud::GpuTimer::End() {
+    glQueryCounter(queries[frame][1], GL_TIMESTAMP);
+    issued[frame] = true;
+    frame = (frame + 1) % FRAMES;
+}
+
+void PerfHud::GpuTimer::Release() {
+    if (queries[0][0]) glDeleteQueries(FRAMES * 2, &queries[0][0]);
+    queries[0][0] = 0;
+}
+
+// --------------------------------------------------------
+// HUD
+// --------------------------------------------------------
+void PerfHud::SetVisible(bool visible) {
+    m_Visible = visible;
+    m_BuiltScene = nullptr;             // Don't show a panel from before it was hidden
+    if (visible && !m_Text.IsValid() && !m_LoadFailed) m_LoadFailed = !Load();
+}
+
+bool PerfHud::Load() {
+    // 1. Font
+    bool loaded = false;
+    if (!m_FontPath.empty()) {
+        loaded = m_Text.Init(m_FontPath, FONT_PX);
+    } else {
+        for (const char* path : DEFAULT_FONTS) {
+            if ((loaded = m_Text.Init(path, FONT_PX))) break;
+        }
+    }
+    if (!loaded) {
+        std::cerr << "HUD: could not load font " << (m_FontPath.empty() ? "DejaVu Sans Mono" : m_FontPath)
+                  << " (--hud-font)" << std::endl;
+        return false;
+    }
+
+    // 2. Panel target (sized by Rebuild) and the quad that composites it
+    glGenTextures(1, &m_PanelTexture);
+    GLStats::BindTexture(GL_TEXTURE_2D, m_PanelTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    GLStats::BindTexture(GL_TEXTURE_2D, 0);
+    glGenFramebuffers(1, &m_PanelFramebuffer);
+    glGenVertexArrays(1, &m_CompositeVAO);      // Corners come from gl_VertexID
+
+    m_CompositeProgram = CompileCompositeProgram();
+    if (!m_CompositeProgram) {
+        Release();
+        return false;
+    }
+    m_RectLoc = glGetUniformLocation(m_CompositeProgram, "uRect");
+    m_ScreenLoc = glGetUniformLocation(m_CompositeProgram, "uScreen");
+    glUseProgram(m_CompositeProgram);
+    glUniform1i(glGetUniformLocation(m_CompositeProgram, "uPanel"), 0);
+    glUseProgram(0);
+    return true;
+}
+
+void PerfHud::Release() {
+    m_Text.Release();
+    glDeleteTextures(1, &m_PanelTexture);
+    glDeleteFramebuffers(1, &m_PanelFramebuffer);
+    glDeleteVertexArrays(1, &m_CompositeVAO);
+    if (m_CompositeProgram) glDeleteProgram(m_CompositeProgram);
+    m_PanelTexture = m_PanelFramebuffer = m_CompositeVAO = m_CompositeProgram = 0;
+    m_PanelWidth = m_PanelHeight = 0;
+    m_SceneGpu.Release();
+    m_HudGpu.Release();
+}
+
+void PerfHud::BeginSceneGpu() {
+    if (!IsVisible()) return;
+    if (m_SceneName && (m_SinceRebuildMs >= REBUILD_MS || m_SceneName != m_BuiltScene)) {
+        auto start = std::chrono::steady_clock::now();
+        Rebuild(m_SceneName, m_SceneBytes);
+        m_RebuildCpuMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    m_SceneGpu.Begin();
+}
+
+void PerfHud::EndSceneGpu() {
+    if (IsVisible()) m_SceneGpu.End();
+}
+
+void PerfHud::OnFrame(double frameMs, double updateMs, double renderMs) {
+    m_History[m_HistoryHead] = (float)frameMs;
+    m_HistoryHead = (m_HistoryHead + 1) % HISTORY;
+    m_UpdateMs = updateMs;
+    m_RenderMs = renderMs;
+    m_SinceRebuildMs += frameMs;
+
+    m_FpsFrames++;
+    m_FpsTime += frameMs;
+    if (m_FpsTime >= 500.0) {
+        m_Fps = m_FpsFrames * 1000.0 / m_FpsTime;
+        m_FpsFrames = 0;
+        m_FpsTime = 0.0;
+    }
+}
+
+void PerfHud::Draw(const char* sceneName, size_t sceneBytes, int width, int height) {
+    if (!IsVisible()) return;
+    auto cpuStart = std::chrono::steady_clock::now();
+    m_HudGpu.Begin();
+
+    // For the next panel (BeginSceneGpu); nothing to show before the first
+    m_SceneName = sceneName;
+    m_SceneBytes = sceneBytes;
+    if (m_BuiltScene) Composite(width, height);
+
+    m_HudGpu.End();
+    m_HudCpuMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cpuStart).count() + m_RebuildCpuMs;
+    m_RebuildCpuMs = 0.0;
+}
+
+// One quad on top of whatever the scene left (the panel is premultiplied)
+void PerfHud::Composite(int width, int height) {
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    glUseProgram(m_CompositeProgram);
+    glUniform4f(m_RectLoc, MARGIN, MARGIN, (float)m_PanelWidth, (float)m_PanelHeight);
+    glUniform2f(m_ScreenLoc, (float)width, (float)height);
+    glActiveTexture(GL_TEXTURE0);
+    GLStats::BindTexture(GL_TEXTURE_2D, m_PanelTexture);
+    glBindVertexArray(m_CompositeVAO);
+    GLStats::DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindVertexArray(0);
+
+    glDisable(GL_BLEND);
+    if (depthTest) glEnable(GL_DEPTH_TEST);
+}
+
+void PerfHud::Rebuild(const char* sceneName, size_t sceneBytes) {
+    m_SinceRebuildMs = 0.0;
+    m_BuiltScene = sceneName;
+
+    // 1. Text, formatted first so the panel can fit the widest line
+    const int LINES = 8;
+    char lines[LINES][160];
+    uint32_t colors[LINES];
+    std::fill(colors, colors + LINES, TEXT);
+
+    float frameMax = *std::max_element(m_History, m_History + HISTORY);
+    float frameLast = m_History[(m_HistoryHead + HISTORY - 1) % HISTORY];
+    GlyphResidency::Stats glyphs = GlyphResidency::Get().GetStats();
+
+    snprintf(lines[0], sizeof(lines[0]), "%s", sceneName);
+    // Until the first half second is in, the running estimate
+    double fps = m_Fps > 0.0 || m_FpsTime <= 0.0 ? m_Fps : m_FpsFrames * 1000.0 / m_FpsTime;
+    snprintf(lines[1], sizeof(lines[1]), "FPS %.1f   frame %.2f ms (max %.2f)", fps, frameLast, frameMax);
+    snprintf(lines[2], sizeof(lines[2]), "CPU  update %.3f  render %.3f ms", m_UpdateMs, m_RenderMs);
+    snprintf(lines[3], sizeof(lines[3]), "GPU  scene %.3f ms", m_SceneGpu.lastMs);
+    if (GLStats::IsInstalled()) {
+        FormatFrameStats(GLStats::GetLastFrame(), lines[4], sizeof(lines[4]));
+    } else {
+        snprintf(lines[4], sizeof(lines[4]), "GL call counts: run with --gl-stats");
+        colors[4] = DIM;
+    }
+    snprintf(lines[5], sizeof(lines[5]), "Memory  scene %.1f MB   glyph VRAM %.1f / %.0f MB", ToMB(sceneBytes),
+             ToMB(glyphs.residentBytes), ToMB(glyphs.budgetBytes));
+    if (AllocTracker::IsCompiled()) {
+        const AllocFrameStats& heap = AllocTracker::GetLastFrame();
+        snprintf(lines[6], sizeof(lines[6]), "Heap  %llu allocs  %.1f KB this frame", (unsigned long long)heap.allocations,
+                 heap.bytes / 1024.0);
+    } else {
+        snprintf(lines[6], sizeof(lines[6]), "Heap: built without GRAPHICSLAB_ALLOC_TRACKING");
+        colors[6] = DIM;
+    }
+    snprintf(lines[7], sizeof(lines[7]), "HUD  cpu %.3f  gpu %.3f ms", m_HudCpuMs, m_HudGpu.lastMs);
+    colors[7] = DIM;
+
+    // Panel coordinates from here on: it is rendered on its own, then composited
+    float lineHeight = m_Text.GetLineHeight();
+    float contentWidth = HISTORY * BAR_WIDTH;
+    for (int i = 0; i < LINES; i++) contentWidth = std::max(contentWidth, m_Text.MeasureText(lines[i]));
+    int panelWidth = (int)std::ceil(contentWidth + 2 * MARGIN);
+    int panelHeight = (int)std::ceil(LINES * lineHeight + GRAPH_HEIGHT + 3 * MARGIN);
+    float x = MARGIN, y = MARGIN;
+
+    m_Text.Begin(panelWidth, panelHeight);
+    m_Text.AddRect(0.0f, 0.0f, (float)panelWidth, (float)panelHeight, PANEL);
+    for (int i = 0; i < LINES; i++) {
+        m_Text.AddText(lines[i], x, y, colors[i]);
+        y += lineHeight;
+    }
+    y += MARGIN;
+
+    // 2. Frame-time graph, oldest on the left, with the 60 Hz budget marked
+    for (int i = 0; i < HISTORY; i++) {
+        float ms = m_History[(m_HistoryHead + i) % HISTORY];
+        float h = std::min(ms / GRAPH_MAX_MS, 1.0f) * GRAPH_HEIGHT;
+        uint32_t color = ms < 16.7f ? GOOD : (ms < 33.3f ? SLOW : BAD);
+        m_Text.AddRect(x + i * BAR_WIDTH, y + GRAPH_HEIGHT - h, BAR_WIDTH - 0.5f, h, color);
+    }
+    m_Text.AddRect(x, y + GRAPH_HEIGHT * (1.0f - 16.7f / GRAPH_MAX_MS), HISTORY * BAR_WIDTH, 1.0f, DIM);
+
+    // 3. Render it. Whatever the host renders into (the headless FBO, say) is put back after.
+    GLint target = 0, viewport[4];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &target);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_PanelFramebuffer);
+    // The size follows the widest line, so it rarely changes (the font is monospaced)
+    if (panelWidth != m_PanelWidth || panelHeight != m_PanelHeight) {
+        GLStats::BindTexture(GL_TEXTURE_2D, m_PanelTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, panelWidth, panelHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        GLStats::BindTexture(GL_TEXTURE_2D, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_PanelTexture, 0);
+        m_PanelWidth = panelWidth;
+        m_PanelHeight = panelHeight;
+    }
+    glViewport(0, 0, panelWidth, panelHeight);
+    const GLfloat transparent[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    glClearBufferfv(GL_COLOR, 0, transparent);
+    m_Text.Draw();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, target);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <GL/glew.h>
+#include "BatchedText.h"
+
+// Performance overlay (F3, or --hud): FPS, a frame-time graph, CPU and GPU
+// timings, GL call counts (with --gl-stats) and memory. Everything is one
+// BatchedText draw; formatting goes into fixed buffers, so showing it costs
+// no allocations. The panel is rendered into a texture a few times a second
+// and composited as one quad in between, which keeps it under 0.1 ms a frame
+// even on a software rasterizer. Its own CPU and GPU cost are shown too.
+//
+// Render thread only. Hidden, every call returns straight away; nothing is
+// loaded until it is first shown.
+class PerfHud {
+public:
+    static const int HISTORY = 120;    // Frames in the graph
+
+    // Font to load on first show. Empty: the first of a few usual places
+    // DejaVu Sans Mono is installed.
+    void SetFont(const std::string& path) { m_FontPath = path; }
+    void Release();
+
+    // Showing it the first time loads the font: needs the context current
+    void Toggle() { SetVisible(!m_Visible); }
+    void SetVisible(bool visible);
+    bool IsVisible() const { return m_Visible && m_Text.IsValid(); }
+
+    // Around the scene's OnRender, for its GPU time. BeginSceneGpu also
+    // re-renders the panel when it's due, before the scene has queued anything,
+    // so switching render targets doesn't split the scene's work in two.
+    void BeginSceneGpu();
+    void EndSceneGpu();
+
+    // CPU side of the frame that just finished (ms)
+    void OnFrame(double frameMs, double updateMs, double renderMs);
+
+    void Draw(const char* sceneName, size_t sceneBytes, int width, int height);
+
+private:
+    // GL_TIMESTAMP pairs, read back a few frames later so nothing stalls
+    struct GpuTimer {
+        static const int FRAMES = 4;
+        GLuint queries[FRAMES][2] = {};
+        bool issued[FRAMES] = {};
+        int frame = 0;
+        double lastMs = 0.0;
+
+        void Begin();
+        void End();
+        void Release();
+    };
+
+    bool Load();
+    void Rebuild(const char* sceneName, size_t sceneBytes);
+    void Composite(int width, int height);
+
+    BatchedText m_Text;
+    std::string m_FontPath;
+    bool m_Visible = false;
+    bool m_LoadFailed = false;          // Don't retry (and re-report) on every toggle
+
+    // The panel, rendered by Rebuild(), and what puts it on screen
+    GLuint m_PanelTexture = 0, m_PanelFramebuffer = 0;
+    GLuint m_CompositeProgram = 0, m_CompositeVAO = 0;
+    GLint m_RectLoc = -1, m_ScreenLoc = -1;
+    int m_PanelWidth = 0, m_PanelHeight = 0;
+
+    // Frame time since the panel was last rendered, and for which scene
+    // (null: not rendered yet). Draw() records what the next one shows.
+    double m_SinceRebuildMs = 0.0;
+    const char* m_BuiltScene = nullptr;
+    const char* m_SceneName = nullptr;
+    size_t m_SceneBytes = 0;
+    double m_RebuildCpuMs = 0.0;
+
+    float m_History[HISTORY] = {};      // Frame times, ring
+    int m_HistoryHead = 0;
+    double m_UpdateMs = 0.0, m_RenderMs = 0.0;
+
+    // FPS over the last half second or so
+    int m_FpsFrames = 0;
+    double m_FpsTime = 0.0;
+    double m_Fps = 0.0;
+
+    GpuTimer m_SceneGpu, m_HudGpu;
+    double m_HudCpuMs = 0.0;
+};
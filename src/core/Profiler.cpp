@@ -0,0 +1,162 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> Profiler::s_Enabled{ false };
+
+namespace {
+const size_t RING_CAPACITY = 1 << 16;   // Zones kept per thread (~1.5 MB)
+
+// A ring slot. Atomic fields (all relaxed), because the exporter may read a
+// slot while the owner overwrites it; 'head' tells it which reads to discard.
+struct ZoneRecord {
+    std::atomic<const char*> name{ nullptr };
+    std::atomic<uint64_t> start{ 0 };
+    std::atomic<uint64_t> end{ 0 };
+};
+
+// Plain copy of a slot, for the exporter
+struct Zone {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+};
+}
+
+// One per thread that ever recorded (plus explicit tracks). Only the owner
+// writes; the exporter reads behind it and discards whatever the owner may
+// have overwritten meanwhile.
+struct ProfilerTrack {
+    int tid = 0;
+    std::string name;
+    std::unique_ptr<ZoneRecord[]> zones{ new ZoneRecord[RING_CAPACITY] };
+    std::atomic<uint64_t> head{ 0 };    // Zones ever written
+    std::atomic<uint64_t> tail{ 0 };    // Zones before this were cleared
+};
+
+namespace {
+// Rings outlive their threads (a worker may exit before the trace is written)
+std::mutex s_RingsMutex;
+std::vector<std::unique_ptr<ProfilerTrack>> s_Rings;
+
+const std::chrono::steady_clock::time_point s_Epoch = std::chrono::steady_clock::now();
+
+ProfilerTrack* AddTrack(const std::string& name) {
+    std::lock_guard<std::mutex> lock(s_RingsMutex);
+    s_Rings.push_back(std::make_unique<ProfilerTrack>());
+    ProfilerTrack* ring = s_Rings.back().get();
+    ring->tid = (int)s_Rings.size();
+    ring->name = name.empty() ? "Thread " + std::to_string(ring->tid) : name;
+    return ring;
+}
+
+thread_local ProfilerTrack* t_Ring = nullptr;
+
+// Created by SetThreadName, or here by the first zone of an unnamed thread
+ProfilerTrack& GetThreadRing() {
+    if (!t_Ring) t_Ring = AddTrack("");
+    return *t_Ring;
+}
+
+void WriteEscaped(FILE* f, const char* s) {
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        fputc(*s, f);
+    }
+}
+}
+
+uint64_t Profiler::Now() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_Epoch).count();
+}
+
+void Profiler::SetThreadName(const char* name) {
+    if (!t_Ring) {
+        t_Ring = AddTrack(name);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(s_RingsMutex);
+    t_Ring->name = name;
+}
+
+void Profiler::Record(const char* name, uint64_t startNs, uint64_t endNs) {
+    Record(&GetThreadRing(), name, startNs, endNs);
+}
+
+ProfilerTrack* Profiler::CreateTrack(const char* name) {
+    return AddTrack(name);
+}
+
+void Profiler::Record(ProfilerTrack* track, const char* name, uint64_t startNs, uint64_t endNs) {
+    uint64_t head = track->head.load(std::memory_order_relaxed);
+    ZoneRecord& slot = track->zones[head & (RING_CAPACITY - 1)];
+
+    // Seqlock-style: an exporter that reads any of the stores below has also
+    // seen 'head' reach this zone's index, which the fence orders before them
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(startNs, std::memory_order_relaxed);
+    slot.end.store(endNs, std::memory_order_relaxed);
+    track->head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::Clear() {
+    std::lock_guard<std::mutex> lock(s_RingsMutex);
+    for (auto& ring : s_Rings) ring->tail.store(ring->head.load());
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path) {
+    FILE* f = fopen(path.c_str(), "w");
+    if (!f) return false;
+
+    std::lock_guard<std::mutex> lock(s_RingsMutex);
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    size_t written = 0;
+
+    for (auto& ring : s_Rings) {
+        // 1. Thread label
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"",
+                first ? "" : ",\n", ring->tid);
+        WriteEscaped(f, ring->name.c_str());
+        fprintf(f, "\"}}");
+        first = false;
+
+        // 2. Snapshot the live part of the ring
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t begin = std::max(ring->tail.load(), head > RING_CAPACITY ? head - RING_CAPACITY : 0);
+        std::vector<Zone> zones;
+        for (uint64_t i = begin; i < head; i++) {
+            const ZoneRecord& slot = ring->zones[i & (RING_CAPACITY - 1)];
+            zones.push_back({ slot.name.load(std::memory_order_relaxed), slot.start.load(std::memory_order_relaxed),
+                              slot.end.load(std::memory_order_relaxed) });
+        }
+
+        // The owner kept going: drop the slots it may have reused under us.
+        // Zone i's slot is rewritten by zone i + RING_CAPACITY, which starts
+        // once head reaches that index (possibly mid-write, hence the >=).
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = ring->head.load(std::memory_order_relaxed);
+        size_t skip = after >= RING_CAPACITY + begin ? (size_t)std::min<uint64_t>(after - RING_CAPACITY - begin + 1, zones.size()) : 0;
+
+        // 3. Complete ("X") events, microseconds
+        for (size_t i = skip; i < zones.size(); i++) {
+            const Zone& z = zones[i];
+            fprintf(f, ",\n{\"name\":\"");
+            WriteEscaped(f, z.name);
+            fprintf(f, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                    ring->tid, z.start * 1e-3, (z.end - z.start) * 1e-3);
+            written++;
+        }
+    }
+
+    fprintf(f, "\n]}\n");
+    bool ok = fclose(f) == 0;
+    printf("Profiler: wrote %zu zones to %s\n", written, path.c_str());
+    return ok;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+struct ProfilerTrack;
+
+// Scoped CPU zones, written to Chrome trace-event JSON (chrome://tracing, Perfetto).
+//
+//   PROFILE_ZONE("Render");          // Until the end of the enclosing scope
+//   PROFILE_FUNCTION();
+//
+// Every thread records into its own fixed-size ring, so recording takes no
+// lock; when a ring wraps, its oldest zones are lost. SetThreadName() creates
+// the calling thread's ring (~1.5 MB). On a thread that was never named, the
+// first zone creates it instead, taking a lock and allocating; after that,
+// recording never allocates. Zones cost one relaxed atomic load while
+// recording is off, and compile to nothing without GRAPHICSLAB_PROFILER
+// (CMake option of the same name).
+class Profiler {
+public:
+    static void SetEnabled(bool enabled) { s_Enabled.store(enabled, std::memory_order_relaxed); }
+    static bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+
+    // Nanoseconds since the profiler's epoch (steady clock)
+    static uint64_t Now();
+
+    // Label for the calling thread in the trace. Also allocates its ring, so
+    // call it when the thread starts, before any zone.
+    static void SetThreadName(const char* name);
+
+    // 'name' must outlive the profiler (string literals)
+    static void Record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // A timeline that isn't a CPU thread (e.g. "GPU"). Only one thread may record on it.
+    static ProfilerTrack* CreateTrack(const char* name);
+    static void Record(ProfilerTrack* track, const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Everything still in the rings. Recording may continue meanwhile.
+    static bool WriteChromeTrace(const std::string& path);
+    static void Clear();
+
+private:
+    static std::atomic<bool> s_Enabled;
+};
+
+class ProfileZone {
+    const char* m_Name;
+    uint64_t m_Start = 0;
+
+public:
+    explicit ProfileZone(const char* name) : m_Name(Profiler::IsEnabled() ? name : nullptr) {
+        if (m_Name) m_Start = Profiler::Now();
+    }
+    ~ProfileZone() {
+        if (m_Name) Profiler::Record(m_Name, m_Start, Profiler::Now());
+    }
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef GRAPHICSLAB_PROFILER
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#endif
@@ -0,0 +1,89 @@
+#include "SceneBenchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+float Ms(std::chrono::steady_clock::duration d) {
+    return std::chrono::duration<float, std::milli>(d).count();
+}
+
+float Percentile(std::vector<float> v, float p) {
+    if (v.empty()) return 0.0f;
+    size_t i = std::min(v.size() - 1, (size_t)(p * (v.size() - 1) + 0.5f));
+    std::nth_element(v.begin(), v.begin() + i, v.end());
+    return v[i];
+}
+
+std::string Stats(const char* name, const std::vector<float>& v) {
+    char buf[160];
+    snprintf(buf, sizeof(buf), "    \"%s\": { \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f }",
+             name, Percentile(v, 0.5f), Percentile(v, 0.95f), Percentile(v, 0.99f),
+             v.empty() ? 0.0f : *std::max_element(v.begin(), v.end()));
+    return buf;
+}
+}
+
+void SceneBenchmark::Init(int frames) {
+    glGenQueries(1, &m_Query);
+
+    // Recording a sample must not allocate in the frames it measures
+    size_t samples = (size_t)std::max(frames - m_Warmup, 0);
+    m_Samples.update.reserve(samples);
+    m_Samples.render.reserve(samples);
+    m_Samples.gpu.reserve(samples);
+    m_Samples.total.reserve(samples);
+}
+
+void SceneBenchmark::Release() {
+    if (m_Query) glDeleteQueries(1, &m_Query);
+    m_Query = 0;
+}
+
+void SceneBenchmark::BeginFrame() {
+    m_FrameStart = Clock::now();
+    glBeginQuery(GL_TIME_ELAPSED, m_Query);
+}
+
+void SceneBenchmark::EndUpdate() {
+    m_UpdateEnd = Clock::now();
+}
+
+void SceneBenchmark::EndRender() {
+    m_RenderEnd = Clock::now();
+    glEndQuery(GL_TIME_ELAPSED);
+}
+
+void SceneBenchmark::EndFrame() {
+    // The frame is done once the GPU is, so the query result is ready too
+    glFinish();
+    Clock::time_point end = Clock::now();
+
+    if (m_Frame++ < m_Warmup) return;
+
+    GLuint64 gpuNs = 0;
+    glGetQueryObjectui64v(m_Query, GL_QUERY_RESULT, &gpuNs);
+
+    m_Samples.update.push_back(Ms(m_UpdateEnd - m_FrameStart));
+    m_Samples.render.push_back(Ms(m_RenderEnd - m_UpdateEnd));
+    m_Samples.gpu.push_back((float)(gpuNs * 1e-6));
+    m_Samples.total.push_back(Ms(end - m_FrameStart));
+}
+
+std::string SceneBenchmark::ToJson(const std::string& scene, int width, int height) const {
+    // The renderer tells a GPU time apart from a software rasterizer's, which does
+    // its work on the CPU before the query ends and reports next to nothing
+    const char* renderer = (const char*)glGetString(GL_RENDERER);
+
+    char header[512];
+    snprintf(header, sizeof(header),
+             "{\n    \"scene\": \"%s\",\n    \"renderer\": \"%s\",\n    \"width\": %d,\n    \"height\": %d,\n"
+             "    \"frames\": %zu,\n    \"warmup\": %d,\n",
+             scene.c_str(), renderer ? renderer : "", width, height, m_Samples.total.size(), m_Warmup);
+
+    return std::string(header) +
+           Stats("update_ms", m_Samples.update) + ",\n" +
+           Stats("render_ms", m_Samples.render) + ",\n" +
+           Stats("gpu_ms", m_Samples.gpu) + ",\n" +
+           Stats("total_ms", m_Samples.total) + "\n}\n";
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <GL/glew.h>
+
+// Frame timings for --bench: one scene, offscreen, a fixed number of frames.
+// Each frame is bracketed by a GL_TIME_ELAPSED query and ends in glFinish(),
+// so frames don't overlap and "total" is the full cost of one frame on this
+// machine (CPU work + waiting for the GPU), independent of vsync or a
+// compositor. The first few frames (lazy GL objects, shader compiles in the
+// driver) are run but not recorded.
+class SceneBenchmark {
+public:
+    explicit SceneBenchmark(int warmupFrames = 10) : m_Warmup(warmupFrames) {}
+
+    // Needs the context current. 'frames': how many will run, warmup included
+    void Init(int frames);
+    void Release();
+
+    // Around each frame, in this order
+    void BeginFrame();
+    void EndUpdate();
+    void EndRender();
+    void EndFrame();
+
+    // { "scene": ..., "renderer": GL_RENDERER, "update_ms": { "p50", "p95", "p99", "max" },
+    //   "render_ms", "gpu_ms", "total_ms" }. Needs the context current.
+    std::string ToJson(const std::string& scene, int width, int height) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Samples {
+        std::vector<float> update, render, gpu, total;     // ms
+    };
+
+    Samples m_Samples;
+    Clock::time_point m_FrameStart, m_UpdateEnd, m_RenderEnd;
+    GLuint m_Query = 0;
+    int m_Warmup = 0;
+    int m_Frame = 0;
+};
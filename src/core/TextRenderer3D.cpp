@@ -2,248 +2,446 @@
 
 // --- STANDARD LIBRARY INCLUDES ---
 #include <iostream>
-#include <fstream>
 #include <cmath>
 #include <vector>
 #include <array>         // <--- REQUIRED: Fixes "incomplete type std::array"
 #include <algorithm>
+#include <filesystem>
 
 // --- GLM EXTENSIONS ---
 #include <glm/gtc/matrix_transform.hpp> // <--- REQUIRED: Fixes glm::translate/scale
 #include <glm/gtc/type_ptr.hpp>         // <--- REQUIRED: Fixes glm::value_ptr
 
 // --- IMPLEMENTATION HEADERS ---
-#define STB_TRUETYPE_IMPLEMENTATION
-#include "../libs/stb_truetype.h"
-
-#include "../libs/earcut.hpp"
-
-// Define the point type for Earcut (Must happen before usage)
-namespace mapbox {
-namespace util {
-template <> struct nth<0, std::array<double, 2>> {
-    inline static double get(const std::array<double, 2> &t) { return t[0]; };
-};
-template <> struct nth<1, std::array<double, 2>> {
-    inline static double get(const std::array<double, 2> &t) { return t[1]; };
-};
+#include "GlyphTessellator.h"
+#include "GlyphArchive.h"
+#include "GlyphCorpus.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "GLStats.h"
+
+// --------------------------------------------------------
+// GLYPH CACHE REGISTRY
+// --------------------------------------------------------
+namespace {
+// (path, face) -> meshes. Archives use face -1. Weak, so the GL objects go
+// away with the last renderer that uses them.
+std::mutex s_CacheMutex;
+std::map<std::pair<std::string, int>, std::weak_ptr<GlyphCache>> s_Caches;
+
+std::shared_ptr<GlyphCache> AcquireGlyphCache(const std::string& path, int faceIndex) {
+    std::lock_guard<std::mutex> lock(s_CacheMutex);
+    auto key = std::make_pair(path, faceIndex);
+    auto it = s_Caches.find(key);
+    if (it != s_Caches.end()) {
+        if (auto existing = it->second.lock()) return existing;
+    }
+    auto cache = std::make_shared<GlyphCache>();
+    s_Caches[key] = cache;
+    return cache;
 }
+
+// A cache whose one-time build failed: the next Acquire starts over with a new one
+void ReleaseGlyphCache(const std::string& path, int faceIndex, const std::shared_ptr<GlyphCache>& cache) {
+    std::lock_guard<std::mutex> lock(s_CacheMutex);
+    auto it = s_Caches.find(std::make_pair(path, faceIndex));
+    if (it != s_Caches.end() && it->second.lock() == cache) s_Caches.erase(it);
 }
 
-TextRenderer3D::TextRenderer3D() {}
+void DeleteGlyphMesh(GlyphMesh& gm) {
+    glDeleteVertexArrays(1, &gm.VAO);
+    glDeleteBuffers(1, &gm.VBO);
+    glDeleteBuffers(1, &gm.EBO);
+}
+}
 
-TextRenderer3D::~TextRenderer3D() {
-    // If the header <map> is missing, this line fails. 
-    // Since we fixed the header, this will now work.
-    for (auto& pair : m_Glyphs) {
-        glDeleteVertexArrays(1, &pair.second.VAO);
-        glDeleteBuffers(1, &pair.second.VBO);
+GlyphCache::~GlyphCache() {
+    for (auto& pair : meshes) {
+        GlyphResidency::Get().OnDestroyed(pair.second);
+        DeleteGlyphMesh(pair.second);
     }
 }
 
+TextRenderer3D::TextRenderer3D() {}
+
+TextRenderer3D::~TextRenderer3D() {}
+
 // --------------------------------------------------------
-// HELPER: Add Point (Fixing the brace initialization error)
+// MESH GENERATION
 // --------------------------------------------------------
-void AddPoint(std::vector<std::array<double, 2>>& poly, float x, float y) {
-    if (poly.empty()) {
-        poly.push_back(std::array<double, 2>{(double)x, (double)y});
-        return;
-    }
-    // Check duplicates
-    std::array<double, 2>& last = poly.back();
-    if (std::abs(last[0] - x) > 0.001 || std::abs(last[1] - y) > 0.001) {
-        poly.push_back(std::array<double, 2>{(double)x, (double)y});
+GlyphMesh* TextRenderer3D::CreateGlyphMesh(FontSlot& slot, int glyphIndex) {
+    GlyphCache& cache = *slot.glyphs;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.meshes.find(glyphIndex);
+        if (it != cache.meshes.end()) return &it->second;
     }
+
+    // Blank glyphs (space) still get an entry so RenderText advances over them
+    GlyphGeometry geometry;
+    TessellateGlyph(&slot.face.info, glyphIndex, geometry);
+    return InsertGlyphMesh(slot, glyphIndex, geometry);
 }
 
-void FlattenCurve(std::vector<std::array<double, 2>>& poly, float x1, float y1, float cx, float cy, float x2, float y2, int depth = 0) {
-    float dx = x2 - x1;
-    float dy = y2 - y1;
-    float d = std::abs((cx - x2) * dy - (cy - y2) * dx);
+void TextRenderer3D::MeshGlyphs(FontSlot& slot, const std::vector<int>& glyphIndices, JobSystem* jobs) {
+    PROFILE_FUNCTION();
+    GlyphCache& cache = *slot.glyphs;
 
-    if (d < 0.5f || depth > 5) { 
-        AddPoint(poly, x2, y2);
-        return;
+    // 1. Only the ones nobody has meshed yet
+    std::vector<int> todo;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        for (int glyphIndex : glyphIndices) {
+            if (cache.meshes.find(glyphIndex) == cache.meshes.end()) todo.push_back(glyphIndex);
+        }
     }
-    
-    float x12 = (x1 + cx) / 2;
-    float y12 = (y1 + cy) / 2;
-    float x23 = (cx + x2) / 2;
-    float y23 = (cy + y2) / 2;
-    float x123 = (x12 + x23) / 2;
-    float y123 = (y12 + y23) / 2;
-
-    FlattenCurve(poly, x1, y1, x12, y12, x123, y123, depth + 1);
-    FlattenCurve(poly, x123, y123, x23, y23, x2, y2, depth + 1);
-}
+    std::sort(todo.begin(), todo.end());
+    todo.erase(std::unique(todo.begin(), todo.end()), todo.end());
+
+    // 2. Tessellate across cores (pure CPU work on read-only font data)
+    std::vector<GlyphGeometry> geometry(todo.size());
+    auto tessellate = [&](size_t begin, size_t end) {
+        PROFILE_ZONE("TessellateGlyphs");
+        for (size_t i = begin; i < end; i++) TessellateGlyph(&slot.face.info, todo[i], geometry[i]);
+    };
+    if (jobs) jobs->ParallelFor(todo.size(), 4, tessellate);
+    else tessellate(0, todo.size());
 
-// --------------------------------------------------------
-// MESH GENERATION
-// --------------------------------------------------------
-void TextRenderer3D::CreateGlyphMesh(char c, const void* infoPtr) {
-    const stbtt_fontinfo* info = (const stbtt_fontinfo*)infoPtr;
-    int glyphIndex = stbtt_FindGlyphIndex(info, c);
-    
-    if (glyphIndex == 0) return;
+    // 3. Upload here: GL calls stay on the thread that owns the context
+    PROFILE_ZONE("UploadGlyphs");
+    for (size_t i = 0; i < todo.size(); i++) InsertGlyphMesh(slot, todo[i], geometry[i]);
+}
 
-    stbtt_vertex* verts;
-    int numVerts = stbtt_GetGlyphShape(info, glyphIndex, &verts);
-    
-    using Point = std::array<double, 2>;
-    using Polygon = std::vector<std::vector<Point>>;
-    Polygon polygon;
-    
-    float startX = 0, startY = 0;
-    float curX = 0, curY = 0;
-
-    for (int i = 0; i < numVerts; ++i) {
-        if (verts[i].type == STBTT_vmove) {
-            polygon.push_back(std::vector<Point>());
-            startX = verts[i].x; startY = verts[i].y;
-            curX = startX; curY = startY;
-            AddPoint(polygon.back(), curX, curY);
-        }
-        else if (verts[i].type == STBTT_vline) {
-            curX = verts[i].x; curY = verts[i].y;
-            AddPoint(polygon.back(), curX, curY);
-        }
-        else if (verts[i].type == STBTT_vcurve) {
-            FlattenCurve(polygon.back(), curX, curY, verts[i].cx, verts[i].cy, verts[i].x, verts[i].y);
-            curX = verts[i].x; curY = verts[i].y;
+GlyphMesh* TextRenderer3D::InsertGlyphMesh(FontSlot& slot, int glyphIndex, const GlyphGeometry& geometry) {
+    GlyphCache& cache = *slot.glyphs;
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    // Another thread may have meshed it in the meantime
+    auto it = cache.meshes.find(glyphIndex);
+    if (it != cache.meshes.end()) return &it->second;
+
+    GlyphMesh& gm = cache.meshes[glyphIndex];
+    gm.indexCount = geometry.indices.size();
+    gm.advance = geometry.advance;
+    gm.minX = geometry.minX; gm.minY = geometry.minY;
+    gm.maxX = geometry.maxX; gm.maxY = geometry.maxY;
+
+    if (gm.indexCount > 0) {
+        // Under a budget, keep a compressed copy so eviction doesn't mean re-tessellating
+        if (GlyphResidency::Get().GetBudget() != 0) {
+            EncodedGlyph& copy = cache.cpuCopies[glyphIndex];
+            EncodeGlyph(glyphIndex, geometry, copy.entry, copy.data);
         }
+        UploadGeometry(gm, geometry, false);
     }
-    stbtt_FreeShape(info, verts);
+    return &gm;
+}
 
-    if (polygon.empty()) return;
+namespace {
+void SetupGlyphVertexLayout() {
+    // Pos
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    // Normal
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+}
+}
 
-    // 1. Triangulate Front Face
-    std::vector<uint32_t> indices = mapbox::earcut<uint32_t>(polygon);
+// Uploads only create buffers, which every context in the share group can use.
+// The VAO is per-context and gets built on first draw (EnsureVertexArray), so
+// glyphs can be meshed on a loader thread. Index data goes through
+// GL_COPY_WRITE_BUFFER because GL_ELEMENT_ARRAY_BUFFER needs a bound VAO.
+// The handles only reach the mesh through GlyphResidency::OnUploaded.
+void TextRenderer3D::UploadGeometry(GlyphMesh& gm, const GlyphGeometry& geometry, bool reupload) {
+    GLuint vbo, ebo;
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
 
-    // 2. Build 3D Mesh Data
-    std::vector<float> meshData;
+    size_t vboBytes = geometry.vertices.size() * sizeof(float);
+    size_t eboBytes = geometry.indices.size() * sizeof(uint32_t);
 
-    auto addVert = [&](float x, float y, float z, float nx, float ny, float nz) {
-        meshData.push_back(x); meshData.push_back(y); meshData.push_back(z);
-        meshData.push_back(nx); meshData.push_back(ny); meshData.push_back(nz);
-    };
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vboBytes, geometry.vertices.data(), GL_STATIC_DRAW);
 
-    // -- FRONT FACE (Z = 0) --
-    for (const auto& ring : polygon) {
-        for (const auto& p : ring) {
-            addVert((float)p[0], (float)p[1], 0.0f, 0, 0, 1);
-        }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, ebo);
+    glBufferData(GL_COPY_WRITE_BUFFER, eboBytes, geometry.indices.data(), GL_STATIC_DRAW);
+
+    GlyphResidency::Get().OnUploaded(gm, vbo, ebo, vboBytes + eboBytes, reupload);
+}
+
+bool TextRenderer3D::UploadEncoded(GlyphMesh& gm, const GlyphArchiveEntry& e, const uint8_t* blob, bool reupload) {
+    GLuint vbo, ebo;
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
+
+    // Allocate storage, then decode directly into the mapped ranges. Load only
+    // bounds-checked the blob; a stream the decoder rejects leaves the buffers
+    // half-written, and they are deleted below before anything draws from them.
+    GLsizeiptr vboBytes = (GLsizeiptr)e.vertexCount * 6 * sizeof(float);
+    GLsizeiptr eboBytes = (GLsizeiptr)e.indexCount * sizeof(uint32_t);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vboBytes, NULL, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, ebo);
+    glBufferData(GL_COPY_WRITE_BUFFER, eboBytes, NULL, GL_STATIC_DRAW);
+
+    GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+    float* verts = (float*)glMapBufferRange(GL_ARRAY_BUFFER, 0, vboBytes, access);
+    uint32_t* indices = (uint32_t*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, eboBytes, access);
+
+    bool ok = verts && indices && DecodeGlyph(e, blob, verts, indices);
+    if (verts) glUnmapBuffer(GL_ARRAY_BUFFER);
+    if (indices) glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+
+    if (!ok) {
+        std::cerr << "Glyph archive: corrupt glyph U+" << std::hex << e.codepoint << std::dec << std::endl;
+        glDeleteBuffers(1, &vbo);
+        glDeleteBuffers(1, &ebo);
+        return false;
     }
 
-    // -- BACK FACE (Z = -1) --
-    int baseBack = meshData.size() / 6; 
-    for (const auto& ring : polygon) {
-        for (const auto& p : ring) {
-            addVert((float)p[0], (float)p[1], -1.0f, 0, 0, -1);
-        }
+    GlyphResidency::Get().OnUploaded(gm, vbo, ebo, vboBytes + eboBytes, reupload);
+    return true;
+}
+
+// Render thread only, which is also the only writer of VAOs
+GLuint TextRenderer3D::EnsureVertexArray(GlyphMesh& gm) {
+    if (gm.VAO != 0) return gm.VAO;
+
+    GLuint vao, vbo, ebo;
+    GlyphResidency::Get().GetBuffers(gm, vbo, ebo);
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    SetupGlyphVertexLayout();
+    GlyphResidency::Get().SetVertexArray(gm, vao);
+    return vao;
+}
+
+bool TextRenderer3D::EnsureResident(FontSlot& slot, uint32_t key, GlyphMesh& gm) {
+    GlyphResidency& residency = GlyphResidency::Get();
+    if (gm.indexCount == 0) return false;
+    if (residency.IsResident(gm)) return true;
+
+    GlyphCache& cache = *slot.glyphs;
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (residency.IsResident(gm)) return true;      // Restored by another thread
+
+    // 1. Compressed CPU copy
+    auto copy = cache.cpuCopies.find(key);
+    if (copy != cache.cpuCopies.end()) {
+        return UploadEncoded(gm, copy->second.entry, copy->second.data.data(), true);
     }
 
-    // -- SIDES --
-    std::vector<uint32_t> sideIndices;
-    int ringOffset = 0;
-    
-    for (const auto& ring : polygon) {
-        int ringSize = ring.size();
-        for (int i = 0; i < ringSize; ++i) {
-            int current = ringOffset + i;
-            int next = ringOffset + ((i + 1) % ringSize);
-            
-            int currentBack = baseBack + current;
-            int nextBack = baseBack + next;
-
-            // Compute Normal
-            float dx = (float)(ring[(i+1)%ringSize][0] - ring[i][0]);
-            float dy = (float)(ring[(i+1)%ringSize][1] - ring[i][1]);
-            float len = sqrt(dx*dx + dy*dy);
-            float nx = dy/len; 
-            float ny = -dx/len;
-
-            // Note: For perfect flat shading we should duplicate verts here with new normals.
-            // For now, we connect existing verts. This creates "smooth" looking corners.
-            // Since we use flat color shader, it's acceptable.
-
-            sideIndices.push_back(current);
-            sideIndices.push_back(next);
-            sideIndices.push_back(currentBack);
-            
-            sideIndices.push_back(next);
-            sideIndices.push_back(nextBack);
-            sideIndices.push_back(currentBack);
-        }
-        ringOffset += ringSize;
+    // 2. Archive
+    if (cache.archive) {
+        const GlyphArchiveEntry* e = cache.archive->Find(key);
+        return e && UploadEncoded(gm, *e, cache.archive->GetBlob(*e), true);
     }
 
-    std::vector<uint32_t> finalIndices = indices;
+    // 3. Font: tessellate again, and keep a copy this time
+    if (!slot.face.IsValid()) return false;
+    GlyphGeometry geometry;
+    TessellateGlyph(&slot.face.info, (int)key, geometry);
+    EncodedGlyph& fresh = cache.cpuCopies[key];
+    EncodeGlyph(key, geometry, fresh.entry, fresh.data);
+    UploadGeometry(gm, geometry, true);
+    return true;
+}
 
-    // Reverse Back Face indices
-    for(size_t i = 0; i < indices.size(); i+=3) {
-        finalIndices.push_back(baseBack + indices[i]);
-        finalIndices.push_back(baseBack + indices[i+2]);
-        finalIndices.push_back(baseBack + indices[i+1]);
+// --------------------------------------------------------
+// FONT CHAIN
+// --------------------------------------------------------
+bool TextRenderer3D::LoadSlot(FontSlot& slot, const std::string& path, int faceIndex) {
+    // 1. Map the file (shared with any other face/renderer already using it)
+    std::shared_ptr<FontFile> file = FontFile::Open(path);
+    if (!file) return false;
+
+    FontFace face;
+    if (!face.Init(file, faceIndex)) return false;
+
+    slot.face = face;
+    slot.emScale = stbtt_ScaleForMappingEmToPixels(&face.info, 1.0f);
+    slot.glyphs = AcquireGlyphCache(file->GetPath(), faceIndex);
+    return true;
+}
+
+bool TextRenderer3D::LoadFont(const std::string& path, int faceIndex) {
+    PROFILE_FUNCTION();
+    FontSlot slot;
+    if (!LoadSlot(slot, path, faceIndex)) return false;
+
+    if (m_Fonts.empty()) m_Fonts.emplace_back();
+    m_Fonts[0] = slot;
+    m_Resolved.clear();
+
+    // 2. Mesh up front: the declared corpus if there is one, printable ASCII otherwise.
+    // Glyphs another renderer already meshed for this face are reused.
+    std::cout << "Generating 3D meshes for font (face " << faceIndex << ")..." << std::endl;
+    if (!m_Corpus.empty()) {
+        PreloadCorpus();
+    } else {
+        std::vector<int> glyphIndices;
+        for (uint32_t c = 32; c < 127; c++) {
+            int glyphIndex = stbtt_FindGlyphIndex(&slot.face.info, c);
+            if (glyphIndex != 0) glyphIndices.push_back(glyphIndex);
+        }
+        MeshGlyphs(m_Fonts[0], glyphIndices, m_Jobs);
     }
+    std::cout << "Done generating." << std::endl;
+    return true;
+}
 
-    finalIndices.insert(finalIndices.end(), sideIndices.begin(), sideIndices.end());
+void TextRenderer3D::SetGlyphCorpus(const GlyphCorpus& corpus) {
+    m_Corpus = corpus.GetCodepoints();
+    PreloadCorpus();
+}
 
-    // Upload
-    GlyphMesh gm;
-    gm.indexCount = finalIndices.size();
-    
-    int advWidth, lsb;
-    stbtt_GetCodepointHMetrics(info, c, &advWidth, &lsb);
-    gm.advance = (float)advWidth;
+void TextRenderer3D::PreloadCorpus() {
+    if (m_Fonts.empty()) return;
+
+    // 1. Find which font each codepoint lands on, and mesh per font in one batch
+    std::vector<std::vector<int>> perSlot(m_Fonts.size());
+    for (uint32_t cp : m_Corpus) {
+        for (size_t i = 0; i < m_Fonts.size(); i++) {
+            if (!m_Fonts[i].glyphs || !m_Fonts[i].face.IsValid()) continue;
+            int glyphIndex = stbtt_FindGlyphIndex(&m_Fonts[i].face.info, cp);
+            if (glyphIndex == 0) continue;
+            perSlot[i].push_back(glyphIndex);
+            break;
+        }
+    }
+    for (size_t i = 0; i < m_Fonts.size(); i++) {
+        if (!perSlot[i].empty()) MeshGlyphs(m_Fonts[i], perSlot[i], m_Jobs);
+    }
+
+    // 2. Resolve() walks the whole chain again, now only finding finished meshes
+    for (uint32_t cp : m_Corpus) Resolve(cp);
+}
 
-    glGenVertexArrays(1, &gm.VAO);
-    glGenBuffers(1, &gm.VBO);
-    GLuint EBO;
-    glGenBuffers(1, &EBO);
+int TextRenderer3D::GetFaceCount(const std::string& path) {
+    std::shared_ptr<FontFile> file = FontFile::Open(path);
+    return file ? file->GetFaceCount() : 0;
+}
 
-    glBindVertexArray(gm.VAO);
+size_t TextRenderer3D::GetMemoryUsage() const {
+    size_t bytes = 0;
+    for (const FontSlot& slot : m_Fonts) {
+        if (!slot.glyphs) continue;
+        std::lock_guard<std::mutex> lock(slot.glyphs->mutex);
+        for (const auto& pair : slot.glyphs->meshes) {
+            if (GlyphResidency::Get().IsResident(pair.second)) bytes += pair.second.gpuBytes;
+        }
+        for (const auto& pair : slot.glyphs->cpuCopies) bytes += pair.second.data.size();
+    }
+    return bytes;
+}
 
-    glBindBuffer(GL_ARRAY_BUFFER, gm.VBO);
-    glBufferData(GL_ARRAY_BUFFER, meshData.size() * sizeof(float), meshData.data(), GL_STATIC_DRAW);
+bool TextRenderer3D::AddFallbackFont(const std::string& path, int faceIndex) {
+    FontSlot slot;
+    if (!LoadSlot(slot, path, faceIndex)) return false;
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, finalIndices.size() * sizeof(uint32_t), finalIndices.data(), GL_STATIC_DRAW);
+    // Slot 0 stays reserved for the primary font: an empty placeholder until LoadFont
+    if (m_Fonts.empty()) m_Fonts.emplace_back();
+    m_Fonts.push_back(slot);
+    m_Resolved.clear();
 
-    // Pos
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    // Normal
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    // Corpus codepoints that now land on this font are meshed here (nothing
+    // without a corpus); any other fallback glyph on its first draw
+    PreloadCorpus();
+    return true;
+}
 
-    glBindVertexArray(0);
-    m_Glyphs[c] = gm;
+void TextRenderer3D::ClearFallbackFonts() {
+    if (m_Fonts.size() > 1) m_Fonts.resize(1);
+    m_Resolved.clear();
 }
 
-bool TextRenderer3D::LoadFont(const std::string& path) {
-    std::ifstream file(path, std::ios::binary | std::ios::ate);
-    if (!file) return false;
+const TextRenderer3D::ResolvedGlyph& TextRenderer3D::Resolve(uint32_t codepoint) {
+    auto it = m_Resolved.find(codepoint);
+    if (it != m_Resolved.end()) return it->second;
+
+    ResolvedGlyph r;
+    float primaryEmScale = m_Fonts.empty() ? 0.0f : m_Fonts[0].emScale;
+
+    for (int i = 0; i < (int)m_Fonts.size(); ++i) {
+        FontSlot& slot = m_Fonts[i];
+        if (!slot.glyphs) continue;
+
+        if (slot.face.IsValid()) {
+            int glyphIndex = stbtt_FindGlyphIndex(&slot.face.info, codepoint);
+            if (glyphIndex == 0) continue;
+            r.glyphIndex = glyphIndex;
+            r.mesh = CreateGlyphMesh(slot, glyphIndex);
+        } else {
+            // Archive: keyed by codepoint, nothing to mesh
+            std::lock_guard<std::mutex> lock(slot.glyphs->mutex);
+            auto m = slot.glyphs->meshes.find(codepoint);
+            if (m == slot.glyphs->meshes.end()) continue;
+            r.glyphIndex = (int)codepoint;
+            r.mesh = &m->second;
+        }
 
-    std::streamsize size = file.tellg();
-    file.seekg(0, std::ios::beg);
+        r.font = i;
+        if (primaryEmScale > 0.0f && slot.emScale > 0.0f) r.scale = slot.emScale / primaryEmScale;
+        break;
+    }
+
+    // Misses are cached too, so a missing codepoint costs one lookup from now on
+    return m_Resolved.emplace(codepoint, r).first->second;
+}
 
-    m_FontBuffer.resize(size);
-    if (!file.read((char*)m_FontBuffer.data(), size)) return false;
+bool TextRenderer3D::LoadGlyphArchive(const std::string& path) {
+    std::error_code ec;
+    std::string key = std::filesystem::weakly_canonical(path, ec).string();
+    if (ec) key = path;
+
+    // call_once stays done even if decoding fails, so a failed cache is
+    // dropped from the registry rather than handed out again
+    std::shared_ptr<GlyphCache> cache = AcquireGlyphCache(key, -1);
+    std::call_once(cache->built, [&]() { cache->valid = DecodeGlyphArchive(*cache, path); });
+    if (!cache->valid) {
+        ReleaseGlyphCache(key, -1, cache);
+        return false;
+    }
 
-    stbtt_fontinfo info;
-    if (!stbtt_InitFont(&info, m_FontBuffer.data(), 0)) return false;
+    if (m_Fonts.empty()) m_Fonts.emplace_back();
+    m_Fonts[0] = FontSlot();
+    m_Fonts[0].glyphs = cache;
+    m_Resolved.clear();
+    return true;
+}
 
-    std::cout << "Generating 3D meshes for font..." << std::endl;
-    for (char c = 32; c < 127; c++) {
-        CreateGlyphMesh(c, &info);
+bool TextRenderer3D::DecodeGlyphArchive(GlyphCache& cache, const std::string& path) {
+    PROFILE_FUNCTION();
+    // The archive stays loaded: it is also where evicted glyphs come back from
+    auto archive = std::make_unique<GlyphArchive>();
+    if (!archive->Load(path)) return false;
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    for (const GlyphArchiveEntry& e : archive->GetEntries()) {
+        GlyphMesh& gm = cache.meshes[e.codepoint];
+        gm.indexCount = e.indexCount;
+        gm.advance = e.advance;
+        gm.minX = e.minX; gm.minY = e.minY;
+        gm.maxX = e.maxX; gm.maxY = e.maxY;
+
+        if (gm.indexCount > 0 && !UploadEncoded(gm, e, archive->GetBlob(e), false)) {
+            cache.meshes.erase(e.codepoint);
+        }
     }
-    std::cout << "Done generating." << std::endl;
 
+    std::cout << "Loaded " << archive->GetEntries().size() << " glyphs from archive." << std::endl;
+    cache.archive = std::move(archive);
     return true;
 }
 
 void TextRenderer3D::RenderText(const std::string& text, float x, float y, float scale, float depth, 
                                 GLuint shader, const float* mat4Value) {
+    PROFILE_FUNCTION();
+    if (m_Fonts.empty()) return;
+
     glUseProgram(shader);
     
     GLint loc = glGetUniformLocation(shader, "uMVP");
@@ -253,22 +451,29 @@ void TextRenderer3D::RenderText(const std::string& text, float x, float y, float
     // Convert raw pointer to GLM for manipulation
     glm::mat4 baseMatrix = glm::make_mat4(mat4Value);
 
-    for (char c : text) {
-        if (m_Glyphs.find(c) == m_Glyphs.end()) continue;
+    for (size_t i = 0; i < text.size(); ) {
+        const ResolvedGlyph& rg = Resolve(DecodeUtf8(text, i));
+        if (!rg.mesh) continue;
         
-        GlyphMesh& gm = m_Glyphs[c];
+        GlyphMesh& gm = *rg.mesh;
+        float glyphScale = scale * rg.scale;
+        // OnDrawn pins the mesh for this frame, so a loader thread can't evict it before the draw
+        bool drawable = gm.indexCount > 0 && EnsureResident(m_Fonts[rg.font], rg.glyphIndex, gm) &&
+                        GlyphResidency::Get().OnDrawn(gm);
         
         glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(cursorX, y, 0.0f));
-        glm::mat4 scaling = glm::scale(glm::mat4(1.0f), glm::vec3(scale, scale, depth)); 
+        glm::mat4 scaling = glm::scale(glm::mat4(1.0f), glm::vec3(glyphScale, glyphScale, depth)); 
         
         glm::mat4 finalMat = baseMatrix * model * scaling;
         
-        glUniformMatrix4fv(loc, 1, GL_FALSE, &finalMat[0][0]);
-        
-        glBindVertexArray(gm.VAO);
-        glDrawElements(GL_TRIANGLES, gm.indexCount, GL_UNSIGNED_INT, 0);
+        if (drawable) {
+            glUniformMatrix4fv(loc, 1, GL_FALSE, &finalMat[0][0]);
+            
+            glBindVertexArray(EnsureVertexArray(gm));
+            GLStats::DrawElements(GL_TRIANGLES, gm.indexCount, GL_UNSIGNED_INT, 0);
+        }
         
-        cursorX += gm.advance * scale;
+        cursorX += gm.advance * glyphScale;
     }
     glBindVertexArray(0);
 }
@@ -3,36 +3,126 @@
 #include <string>
 #include <vector>
 #include <map>           // <--- Critical: Defines std::map
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <cstdint>
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include "FontFile.h"
+#include "GlyphArchive.h"
+#include "GlyphResidency.h"
+
+struct GlyphGeometry;
+class GlyphCorpus;
+class JobSystem;
 
 // 1. Define the structure for the letter mesh
 struct GlyphMesh {
-    GLuint VAO, VBO;
-    int indexCount;
-    float advance; 
-    float minX, minY, maxX, maxY; 
+    GLuint VAO = 0, VBO = 0, EBO = 0;   // VAO: render context only, created on first draw
+    int indexCount = 0;
+    float advance = 0.0f;
+    float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+
+    // Residency (managed by GlyphResidency, which also owns writes to the
+    // handles above). Metrics stay valid while evicted.
+    bool resident = false;
+    bool evicting = false;              // Picked as a victim, deleted at the next frame boundary
+    size_t gpuBytes = 0;
+    uint64_t lastDrawnFrame = 0;
+    GlyphResidency::LruList::iterator lruPos;
+};
+
+// 2. The loaded 3D letters for one (file, face), keyed by glyph index
+// (by codepoint for archives, which have no font to map through).
+// Shared by every TextRenderer3D that loads the same face, so it is meshed once.
+struct GlyphCache {
+    std::mutex mutex;                   // Guards meshes/cpuCopies (a loader thread may be filling them)
+    std::map<uint32_t, GlyphMesh> meshes;
+    std::once_flag built;
+    bool valid = false;                 // Set by the call that ran 'built'
+
+    // Where evicted meshes are rebuilt from: compressed CPU copies (kept while
+    // a residency budget is set), or the archive for archive caches. Font
+    // glyphs without either are re-tessellated.
+    std::map<uint32_t, EncodedGlyph> cpuCopies;
+    std::unique_ptr<GlyphArchive> archive;
+
+    ~GlyphCache();
 };
 
-// 2. Define the class
+// 3. Define the class
 class TextRenderer3D {
 private:
-    // This map stores the loaded 3D letters. 
-    // If this line is missing in your file, the .cpp file will fail.
-    std::map<char, GlyphMesh> m_Glyphs;
-    
-    std::vector<unsigned char> m_FontBuffer; 
-    float m_ExtrusionDepth = 10.0f; 
+    // One link of the font chain. Slot 0 is the primary font, the rest are
+    // fallbacks in the order they were added. Fallbacks added before any
+    // LoadFont() sit behind an unloaded slot 0 (glyphs null), which lookups skip.
+    struct FontSlot {
+        FontFace face;                          // Invalid for archive slots
+        std::shared_ptr<GlyphCache> glyphs;     // Null: slot not loaded
+        float emScale = 0.0f;                   // 1 / unitsPerEm (0 for archives)
+    };
+
+    // Where a codepoint landed after walking the chain (font -1: nowhere).
+    struct ResolvedGlyph {
+        int font = -1;
+        int glyphIndex = 0;
+        GlyphMesh* mesh = nullptr;
+        float scale = 1.0f;                     // Fallback units -> primary units
+    };
+
+    std::vector<FontSlot> m_Fonts;
+    std::unordered_map<uint32_t, ResolvedGlyph> m_Resolved;   // Each chain is walked once per codepoint
+    std::vector<uint32_t> m_Corpus;                           // Declared codepoints (empty: ASCII preload)
+
+    float m_ExtrusionDepth = 10.0f;
+    JobSystem* m_Jobs = nullptr;                              // Optional: parallel tessellation
 
     // Helper function definition
-    void CreateGlyphMesh(char c, const void* fontInfo);
+    static bool LoadSlot(FontSlot& slot, const std::string& path, int faceIndex);
+    static GlyphMesh* CreateGlyphMesh(FontSlot& slot, int glyphIndex);
+    static GlyphMesh* InsertGlyphMesh(FontSlot& slot, int glyphIndex, const GlyphGeometry& geometry);
+    static void MeshGlyphs(FontSlot& slot, const std::vector<int>& glyphIndices, JobSystem* jobs);
+    static void UploadGeometry(GlyphMesh& gm, const GlyphGeometry& geometry, bool reupload);
+    static bool UploadEncoded(GlyphMesh& gm, const GlyphArchiveEntry& entry, const uint8_t* blob, bool reupload);
+    static GLuint EnsureVertexArray(GlyphMesh& gm);
+    static bool EnsureResident(FontSlot& slot, uint32_t key, GlyphMesh& gm);
+    static bool DecodeGlyphArchive(GlyphCache& cache, const std::string& path);
+    const ResolvedGlyph& Resolve(uint32_t codepoint);
+    void PreloadCorpus();
 
 public:
     TextRenderer3D();
     ~TextRenderer3D();
 
-    bool LoadFont(const std::string& path);
-    
-    void RenderText(const std::string& text, float x, float y, float scale, float depth, 
+    // Preloads then tessellate on the job system's workers (uploads stay on
+    // the calling thread). Set before LoadFont/SetGlyphCorpus.
+    void SetJobSystem(JobSystem* jobs) { m_Jobs = jobs; }
+
+    // faceIndex selects a face inside a collection (.ttc); plain fonts only have face 0.
+    bool LoadFont(const std::string& path, int faceIndex = 0);
+    static int GetFaceCount(const std::string& path);
+
+    // GPU bytes of resident glyphs plus their compressed CPU copies, across the
+    // font chain. Caches shared with other renderers are counted in full.
+    size_t GetMemoryUsage() const;
+
+    // Fonts searched, in order, for codepoints the primary font lacks, with their
+    // glyphs scaled to the primary font's em size. Glyphs in the corpus
+    // (SetGlyphCorpus) are meshed when the font is added, the rest on first use.
+    bool AddFallbackFont(const std::string& path, int faceIndex = 0);
+    void ClearFallbackFonts();
+
+    // Meshes exactly the glyphs 'corpus' needs, across the whole font chain, and
+    // makes later LoadFont() calls preload those instead of printable ASCII.
+    // Anything outside the corpus is still meshed lazily if it is ever drawn.
+    void SetGlyphCorpus(const GlyphCorpus& corpus);
+
+    // Loads pre-baked meshes (see tools/GlyphBake.cpp) instead of tessellating a font.
+    // Decodes straight into mapped GL buffers. Replaces the primary font.
+    bool LoadGlyphArchive(const std::string& path);
+
+    // 'text' is UTF-8.
+    void RenderText(const std::string& text, float x, float y, float scale, float depth,
                     GLuint shaderProgram, const float* transformMatrix);
 };
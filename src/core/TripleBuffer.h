@@ -0,0 +1,37 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer / single-consumer hand-off of a value.
+// The writer fills Back() and Publish()es it; the reader's Latest() always
+// returns the newest complete value. Neither side ever waits on the other:
+// there are three slots, one owned by each side and one in the middle.
+template <typename T>
+class TripleBuffer {
+    static constexpr uint8_t INDEX_MASK = 3;
+    static constexpr uint8_t FRESH_BIT = 4;     // Middle slot holds something the reader hasn't seen
+
+    T m_Slots[3];
+    std::atomic<uint8_t> m_Middle{ 1 };
+    uint8_t m_Back = 0;                         // Writer only
+    uint8_t m_Front = 2;                        // Reader only
+
+public:
+    // --- Writer ---
+    T& Back() { return m_Slots[m_Back]; }
+
+    void Publish() {
+        uint8_t old = m_Middle.exchange(m_Back | FRESH_BIT, std::memory_order_acq_rel);
+        m_Back = old & INDEX_MASK;
+    }
+
+    // --- Reader ---
+    // Same value as last time if nothing new was published
+    const T& Latest() {
+        if (m_Middle.load(std::memory_order_relaxed) & FRESH_BIT) {
+            uint8_t old = m_Middle.exchange(m_Front, std::memory_order_acq_rel);
+            m_Front = old & INDEX_MASK;
+        }
+        return m_Slots[m_Front];
+    }
+};
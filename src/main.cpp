@@ -1,23 +1,343 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <string>
 
 // --- SCENE HEADERS ---
+// Including a scene header registers it (REGISTER_SCENE)
 #include "scenes/Scene.h" 
+#include "scenes/SceneRegistry.h"
+#include "scenes/SceneCache.h"
+#include "scenes/SceneLoader.h"
+#include "scenes/SimulationThread.h"
 #include "scenes/Scene01_ClearColor.h"
 #include "scenes/Scene02_Input.h"
 #include "scenes/Scene03_MouseInput.h"
 #include "scenes/Scene04_Optimized.h"
 
+#include "core/GlyphResidency.h"
+#include "core/FixedTimestep.h"
+#include "core/JobSystem.h"
+#include "core/Input.h"
+#include "core/InputRecording.h"
+#include "core/FramePacer.h"
+#include "core/LatencyTracker.h"
+#include "core/HeadlessContext.h"
+#include "core/SceneBenchmark.h"
+#include "core/Profiler.h"
+#include "core/GpuProfiler.h"
+#include "core/GLStats.h"
+#include "core/PerfHud.h"
+#include "core/AllocTracker.h"
+
 // Settings
 const unsigned int SCR_WIDTH = 1280;
 const unsigned int SCR_HEIGHT = 720;
+const size_t GLYPH_VRAM_BUDGET = 256 * 1024 * 1024;   // Glyph meshes beyond this get evicted (LRU)
+const double SIM_STEP = 1.0 / 60.0;                    // Fixed simulation step (seconds)
+const int MAX_SIM_STEPS = 5;                           // Catch-up cap per frame
+const size_t SCENE_CACHE_BUDGET = 64 * 1024 * 1024;    // Suspended scenes kept attached up to this
+const int ALLOC_WARMUP_FRAMES = 10;                    // Headless frames before allocations count as steady state
+
+// Command line
+struct LaunchOptions {
+    bool threadedSim = false;       // --sim-thread: OnUpdate on its own thread (scenes that support it)
+    bool idleRendering = false;     // --idle: only redraw on input or when the scene animates
+    int swapInterval = 1;           // --vsync 0|1
+    double fpsCap = 0.0;            // --fps-cap N (0 = off)
+    int maxFramesInFlight = 2;      // --frames-in-flight N (0 = driver decides)
+    bool measureLatency = false;    // --latency: input-to-photon percentiles per scene, printed on exit
+
+    // --headless: no window, render offscreen (EGL) and exit
+    bool headless = false;
+    int sceneId = 1;                // --scene N, or --scene all (0): every registered scene in turn
+    int frames = 60;                // --frames N
+    int width = SCR_WIDTH;          // --size WxH
+    int height = SCR_HEIGHT;
+    std::string screenshot;         // --screenshot out.ppm: last frame
+    std::string font;               // --font file.ttf: for the text scenes instead of their own
+
+    // --bench N: headless scene N with frame timings, printed as JSON
+    bool bench = false;
+    std::string benchOut;           // --bench-out file.json: also write it here
+
+    // --profile: record CPU zones from startup and write them on exit (F9 toggles at runtime)
+    bool profile = false;
+    std::string traceOut = "graphicslab_trace.json";    // --trace-out file.json
+
+    bool glStats = false;           // --gl-stats: count GL calls per frame, shown in the window title
+
+    bool hud = false;               // --hud: performance overlay from the start (F3 toggles)
+    std::string hudFont;            // --hud-font file.ttf (default: DejaVu Sans Mono, if installed)
 
-// Track which scene is active to prevent reloading it every frame
-int activeSceneIndex = 1; 
+    // --alloc-stats: heap allocations per frame (window title; headless: steady-state
+    // summary and call sites). --assert-no-alloc: headless, fail if steady-state frames allocate.
+    bool allocStats = false;
+    bool assertNoAlloc = false;
+
+    // --record file.input: save the input the scenes saw (window runs).
+    // --replay file.input: feed a recording instead of live input, step by step.
+    std::string recordPath;
+    std::string replayPath;
+};
+
+LaunchOptions ParseOptions(int argc, char** argv) {
+    LaunchOptions o;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sim-thread") o.threadedSim = true;
+        else if (arg == "--idle") o.idleRendering = true;
+        else if (arg == "--vsync" && hasValue) o.swapInterval = std::atoi(argv[++i]);
+        else if (arg == "--fps-cap" && hasValue) o.fpsCap = std::atof(argv[++i]);
+        else if (arg == "--frames-in-flight" && hasValue) o.maxFramesInFlight = std::atoi(argv[++i]);
+        else if (arg == "--latency") o.measureLatency = true;
+        else if (arg == "--headless") o.headless = true;
+        else if (arg == "--scene" && hasValue) {
+            std::string id = argv[++i];
+            o.sceneId = id == "all" ? 0 : std::atoi(id.c_str());
+        }
+        else if (arg == "--frames" && hasValue) o.frames = std::atoi(argv[++i]);
+        else if (arg == "--size" && hasValue) std::sscanf(argv[++i], "%dx%d", &o.width, &o.height);
+        else if (arg == "--screenshot" && hasValue) o.screenshot = argv[++i];
+        else if (arg == "--font" && hasValue) o.font = argv[++i];
+        else if (arg == "--bench" && hasValue) {
+            o.bench = o.headless = true;
+            o.sceneId = std::atoi(argv[++i]);
+        }
+        else if (arg == "--bench-out" && hasValue) o.benchOut = argv[++i];
+        else if (arg == "--profile") o.profile = true;
+        else if (arg == "--trace-out" && hasValue) o.traceOut = argv[++i];
+        else if (arg == "--gl-stats") o.glStats = true;
+        else if (arg == "--hud") o.hud = true;
+        else if (arg == "--hud-font" && hasValue) o.hudFont = argv[++i];
+        else if (arg == "--alloc-stats") o.allocStats = true;
+        else if (arg == "--assert-no-alloc") o.allocStats = o.assertNoAlloc = o.headless = true;
+        else if (arg == "--record" && hasValue) o.recordPath = argv[++i];
+        else if (arg == "--replay" && hasValue) o.replayPath = argv[++i];
+        else std::cerr << "Unknown option: " << arg << std::endl;
+    }
+    return o;
+}
+
+// Set by the key listener, consumed once at the top of the next frame
+int requestedSceneIndex = 0;
+// Cold scene being loaded in the background (0 = none)
+int pendingSceneIndex = 0;
+
+// --------------------------------------
+// HEADLESS
+// --------------------------------------
+// Same scenes, no window: a fixed number of frames into an offscreen FBO.
+// There is no real clock or input device, so every frame is exactly one
+// simulation step and the only input is the framebuffer size, or a --replay
+// recording (steps line up with its steps; use the recorded --size): runs
+// are deterministic, which is what --bench relies on. The background loader,
+// sim thread and latency tracker all need GLFW and stay off.
+bool LoadReplay(InputRecording& recording, const std::string& path) {
+    if (!recording.Load(path)) {
+        std::cerr << "Failed to load input recording " << path << std::endl;
+        return false;
+    }
+    if (recording.GetStepSeconds() != SIM_STEP) {
+        std::cerr << "Warning: " << path << " was recorded with a " << recording.GetStepSeconds()
+                  << " s step, replaying at " << SIM_STEP << " s" << std::endl;
+    }
+    std::cout << "Replaying " << path << ": " << recording.GetEntries().size() << " events over "
+              << recording.GetStepCount() << " steps" << std::endl;
+    return true;
+}
+
+int RunHeadless(const LaunchOptions& options) {
+    HeadlessContext headless;
+    if (!headless.Create(options.width, options.height)) return -1;
+    if (options.glStats) GLStats::Install();
+
+    GlyphResidency::Get().SetBudget(GLYPH_VRAM_BUDGET);
+
+    JobSystem jobs;
+    SceneContext context;
+    context.jobs = &jobs;
+    context.fontPath = options.font;
+
+    SceneCache scenes(SCENE_CACHE_BUDGET, &context);
+    if (!SceneRegistry::Get().FindById(options.sceneId)) {
+        std::cerr << "Unknown scene: " << options.sceneId << std::endl;
+        return -1;
+    }
+    Scene* scene = scenes.Activate(options.sceneId);
+    std::cout << "Loaded: " << scene->GetName() << std::endl;
+    if (options.bench && scene->HasLoadFailed()) {
+        std::cerr << scene->GetName() << ": failed to load its assets, not benchmarking it" << std::endl;
+        return -1;
+    }
+
+    InputSystem input;
+    InputEvent size;
+    size.type = InputEvent::WindowSize;
+    size.x = options.width;
+    size.y = options.height;
+    input.Push(size);
+
+    InputRecording replay;
+    if (!options.replayPath.empty()) {
+        if (!LoadReplay(replay, options.replayPath)) return -1;
+        if (options.frames < (int)replay.GetStepCount()) {
+            std::cout << "Replay: running " << options.frames << " of its steps (--frames)" << std::endl;
+        }
+        input.StartReplay(&replay);
+    }
+
+    SceneBenchmark bench;
+    if (options.bench) bench.Init(options.frames);
+
+    // Drawn inside the render phase, so --bench --hud measures its cost
+    PerfHud hud;
+    hud.SetFont(options.hudFont);
+    hud.SetVisible(options.hud);
+
+    using Clock = std::chrono::steady_clock;
+    auto Ms = [](Clock::time_point a, Clock::time_point b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+
+    // Steady state: every frame after the warmup, which is allowed to
+    // create lazy GL objects, mesh glyphs, grow buffers...
+    AllocFrameStats steadyAllocs;
+    int allocatingFrames = 0, firstAllocatingFrame = -1;
+    auto CountAllocs = [&](int frame) {
+        AllocTracker::BeginFrame();
+        const AllocFrameStats& last = AllocTracker::GetLastFrame();
+        if (frame - 1 < ALLOC_WARMUP_FRAMES || last.allocations == 0) return;
+        if (allocatingFrames++ == 0) firstAllocatingFrame = frame - 1;
+        steadyAllocs.allocations += last.allocations;
+        steadyAllocs.bytes += last.bytes;
+    };
+
+    for (int frame = 0; frame < options.frames; frame++) {
+        if (options.bench) bench.BeginFrame();
+        Clock::time_point frameStart = Clock::now();
+
+        CountAllocs(frame);
+        if (options.allocStats && frame == ALLOC_WARMUP_FRAMES) {
+            AllocTracker::ClearCallsites();
+            AllocTracker::SetCallsiteCapture(true);
+        }
+
+        GlyphResidency::Get().BeginFrame();
+        GpuProfiler::Get().BeginFrame(scene->GetName());
+        GLStats::BeginFrame();
+        {
+            PROFILE_ZONE("Update");
+            scene->OnUpdate((float)SIM_STEP, input.BeginStep((float)SIM_STEP));
+        }
+        if (options.bench) bench.EndUpdate();
+        Clock::time_point updateEnd = Clock::now();
+
+        {
+            PROFILE_ZONE("Render");
+            hud.BeginSceneGpu();
+            scene->OnRender(1.0f);
+            hud.EndSceneGpu();
+        }
+        Clock::time_point renderEnd = Clock::now();
+        if (hud.IsVisible()) hud.Draw(scene->GetName(), scene->GetMemoryUsage(), options.width, options.height);
+
+        if (options.bench) {
+            bench.EndRender();
+            bench.EndFrame();
+        }
+        hud.OnFrame(Ms(frameStart, Clock::now()), Ms(frameStart, updateEnd), Ms(updateEnd, renderEnd));
+    }
+    CountAllocs(options.frames);
+    AllocTracker::SetCallsiteCapture(false);
+    glFinish();
+
+    int status = 0;
+    if (options.allocStats) {
+        int steadyFrames = std::max(options.frames - ALLOC_WARMUP_FRAMES, 0);
+        if (!AllocTracker::IsCompiled()) {
+            std::cerr << "Allocation tracking is not compiled in (GRAPHICSLAB_ALLOC_TRACKING)" << std::endl;
+            if (options.assertNoAlloc) status = -1;
+        } else if (allocatingFrames == 0) {
+            std::cout << "Allocations: none in " << steadyFrames << " steady-state frames" << std::endl;
+        } else {
+            std::cout << "Allocations: " << steadyAllocs.allocations << " (" << steadyAllocs.bytes << " bytes) in "
+                      << allocatingFrames << " of " << steadyFrames << " steady-state frames, first in frame "
+                      << firstAllocatingFrame << std::endl;
+            AllocTracker::PrintCallsites();
+            if (options.assertNoAlloc) {
+                std::cerr << scene->GetName() << ": steady-state frames allocate (--assert-no-alloc)" << std::endl;
+                status = -1;
+            }
+        }
+    }
+    if (options.glStats) {
+        GLStats::BeginFrame();
+        char stats[160];
+        FormatFrameStats(GLStats::GetLastFrame(), stats, sizeof(stats));
+        std::cout << "GL (last frame): " << stats << std::endl;
+    }
+    if (options.bench) {
+        std::string json = bench.ToJson(scene->GetName(), options.width, options.height);
+        std::cout << json;
+        if (!options.benchOut.empty()) {
+            std::ofstream out(options.benchOut);
+            out << json;
+            if (!out) {
+                std::cerr << "Failed to write " << options.benchOut << std::endl;
+                status = -1;
+            }
+        }
+        bench.Release();
+    }
+    hud.Release();
+    GpuProfiler::Get().Release();
+    GpuProfiler::Get().PrintReport();
+
+    if (!options.screenshot.empty()) {
+        if (headless.WritePPM(options.screenshot)) {
+            std::cout << "Wrote " << options.screenshot << std::endl;
+        } else {
+            std::cerr << "Failed to write " << options.screenshot << std::endl;
+            status = -1;
+        }
+    }
+
+    GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+        std::cerr << "GL error 0x" << std::hex << error << std::dec << std::endl;
+        status = -1;
+    }
+
+    scenes.Clear();
+    headless.Destroy();
+    if (Profiler::IsEnabled()) Profiler::WriteChromeTrace(options.traceOut);
+    return status;
+}
+
+int main(int argc, char** argv) {
+    LaunchOptions options = ParseOptions(argc, argv);
+    Profiler::SetThreadName("Main");
+    Profiler::SetEnabled(options.profile);
+    if (options.headless) {
+        if (options.sceneId != 0) return RunHeadless(options);
+
+        // --scene all: one run per scene, failing if any of them does
+        int status = 0;
+        for (const SceneInfo& info : SceneRegistry::Get().GetScenes()) {
+            LaunchOptions sceneOptions = options;
+            sceneOptions.sceneId = info.id;
+            if (RunHeadless(sceneOptions) != 0) status = -1;
+        }
+        return status;
+    }
 
-int main() {
     // 1. Init GLFW
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW" << std::endl;
@@ -46,66 +366,254 @@ int main() {
     }
 
     std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
+    if (options.glStats) GLStats::Install();
+
+    GlyphResidency::Get().SetBudget(GLYPH_VRAM_BUDGET);
+
+    // F3 toggles it, and loads it the first time; a missing font only costs the overlay
+    PerfHud hud;
+    hud.SetFont(options.hudFont);
+    hud.SetVisible(options.hud);
+
+    // --- FRAME PACING ---
+    glfwSwapInterval(options.swapInterval);
+    FramePacer pacer;
+    pacer.Configure(options.maxFramesInFlight, options.fpsCap);
 
     // --------------------------------------
     // INITIALIZATION
     // --------------------------------------
+    // Shared by all scenes
+    JobSystem jobs;
+    SceneContext context;
+    context.jobs = &jobs;
+    context.fontPath = options.font;
+    std::cout << "Job system: " << jobs.GetWorkerCount() << " workers" << std::endl;
+
     // Start with Scene 1 by default
-    std::unique_ptr<Scene> currentScene = std::make_unique<Scene01_ClearColor>();
-    currentScene->OnAttach();
-    activeSceneIndex = 1;
+    SceneCache scenes(SCENE_CACHE_BUDGET, &context);
+    Scene* currentScene = scenes.Activate(1);
     
     std::cout << "Loaded: " << currentScene->GetName() << std::endl;
 
+    // --- INPUT ---
+    // GLFW callbacks feed a queue that the update thread drains into a
+    // per-step snapshot. Hotkeys are resolved through the registry on key
+    // events only, so the loop does no per-scene polling.
+    InputSystem input;
+    input.Install(window);
+    input.SetKeyListener([&options, &hud](int key, int action) {
+        if (action != GLFW_PRESS) return;
+
+        if (key == GLFW_KEY_F3) {
+            hud.Toggle();
+            return;
+        }
+
+        // F9: start a capture, or stop it and write the trace
+        if (key == GLFW_KEY_F9) {
+            if (!Profiler::IsEnabled()) {
+                Profiler::Clear();
+                Profiler::SetEnabled(true);
+                std::cout << "Profiler: recording (F9 to stop)" << std::endl;
+            } else {
+                Profiler::SetEnabled(false);
+                GpuProfiler::Get().Flush();
+                Profiler::WriteChromeTrace(options.traceOut);
+            }
+            return;
+        }
+        if (const SceneInfo* info = SceneRegistry::Get().FindByKey(key)) {
+            requestedSceneIndex = info->id;
+        }
+    });
+
+    // Recording starts before the first step, so it includes the starting
+    // window size and cursor position that Install() queued
+    InputRecording recording, replay;
+    if (!options.recordPath.empty()) {
+        recording.SetStepSeconds(SIM_STEP);
+        input.StartRecording(&recording);
+    }
+    if (!options.replayPath.empty()) {
+        if (!LoadReplay(replay, options.replayPath)) return -1;
+        input.StartReplay(&replay);
+    }
+
+    LatencyTracker latency;
+    if (options.measureLatency) {
+        latency.Init();
+        input.SetLatencyTracker(&latency);
+    }
+
+    // Cold scenes load on a shared context in the background
+    SceneLoader loader;
+    loader.Start(window, &context);
+
+    SimulationThread sim;
+    if (options.threadedSim) sim.Start(SIM_STEP, MAX_SIM_STEPS, &input);
+
+    FixedTimestep simClock(SIM_STEP, MAX_SIM_STEPS);
+    double lastTime = glfwGetTime();
+
     // --------------------------------------
     // GAME LOOP
     // --------------------------------------
+    double lastTitleUpdate = 0.0;
     while (!glfwWindowShouldClose(window)) {
+        GlyphResidency::Get().BeginFrame();
+        GLStats::BeginFrame();
+        AllocTracker::BeginFrame();
+
+        // GL call counts / allocations of the last frame, a couple of times a second
+        if ((options.glStats || options.allocStats) && glfwGetTime() - lastTitleUpdate > 0.5) {
+            lastTitleUpdate = glfwGetTime();
+            char title[256];
+            int n = snprintf(title, sizeof(title), "GraphicsLab [Arch]");
+            if (options.glStats) {
+                n += snprintf(title + n, sizeof(title) - n, " | ");
+                n += FormatFrameStats(GLStats::GetLastFrame(), title + n, sizeof(title) - n);
+            }
+            if (options.allocStats) {
+                n += snprintf(title + n, sizeof(title) - n, " | %llu allocs",
+                              (unsigned long long)AllocTracker::GetLastFrame().allocations);
+            }
+            glfwSetWindowTitle(window, title);
+        }
+
+        // --- TIMING ---
+        double now = glfwGetTime();
+        double frameTime = now - lastTime;
+        lastTime = now;
         
         // --- INPUT: SCENE SWITCHING ---
-        // We add '&& activeSceneIndex != X' to ensure we only load it ONCE per key press
-        
-        // Key '1' -> Load Scene 01
-        if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS && activeSceneIndex != 1) {
-            currentScene = std::make_unique<Scene01_ClearColor>();
-            currentScene->OnAttach();
-            activeSceneIndex = 1;
-            std::cout << "Switched to Scene 1" << std::endl;
+        // Cached scenes are resumed on the spot. Cold ones are loaded in the
+        // background while the current scene keeps rendering.
+        if (requestedSceneIndex != 0 && requestedSceneIndex != scenes.GetActiveId()) {
+            if (scenes.Contains(requestedSceneIndex) || !loader.IsRunning()) {
+                sim.SetScene(nullptr);      // Never suspend a scene mid-update
+                currentScene = scenes.Activate(requestedSceneIndex);
+                pendingSceneIndex = 0;
+                std::cout << "Switched to " << currentScene->GetName() << std::endl;
+            } else {
+                loader.Request(requestedSceneIndex);
+                pendingSceneIndex = requestedSceneIndex;
+            }
+        } else if (requestedSceneIndex != 0) {
+            pendingSceneIndex = 0;      // Back to the active one: forget the pending load
         }
+        requestedSceneIndex = 0;
 
-        // Key '2' -> Load Scene 02
-        if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS && activeSceneIndex != 2) {
-            currentScene = std::make_unique<Scene02_Input>();
-            currentScene->OnAttach();
-            activeSceneIndex = 2;
-            std::cout << "Switched to Scene 2" << std::endl;
+        // Commit a background load once it is ready. If the user has moved on,
+        // cache it suspended so switching to it later doesn't load it again.
+        int readyIndex = 0;
+        if (std::unique_ptr<Scene> ready = loader.TakeReady(readyIndex)) {
+            if (readyIndex == pendingSceneIndex) {
+                sim.SetScene(nullptr);
+                currentScene = scenes.Adopt(readyIndex, std::move(ready));
+                pendingSceneIndex = 0;
+                std::cout << "Switched to " << currentScene->GetName() << std::endl;
+            } else {
+                scenes.AdoptSuspended(readyIndex, std::move(ready));
+            }
         }
 
-        // Key '3' -> Load Scene 03
-        if (glfwGetKey(window, GLFW_KEY_3) == GLFW_PRESS && activeSceneIndex != 3) {
-            currentScene = std::make_unique<Scene03_MouseInput>();
-            currentScene->OnAttach();
-            activeSceneIndex = 3;
-            std::cout << "Switched to Scene 3" << std::endl;
+        // Hand the active scene to the simulation thread if it can take it
+        if (options.threadedSim) {
+            Scene* simulated = currentScene->SupportsThreadedUpdate() ? currentScene : nullptr;
+            if (sim.GetScene() != simulated) sim.SetScene(simulated);
         }
 
-        // Key '4' -> Load Scene 04 (FIXED TYPO HERE)
-        if (glfwGetKey(window, GLFW_KEY_4) == GLFW_PRESS && activeSceneIndex != 4) {
-            // FIXED: Was creating Scene03, changed to Scene04_Optimized
-            currentScene = std::make_unique<Scene04_Optimized>(); 
-            currentScene->OnAttach();
-            activeSceneIndex = 4;
-            std::cout << "Switched to Scene 4" << std::endl;
+        // --- UPDATE & RENDER ---
+        // Simulation runs in fixed steps; rendering interpolates in between
+        GpuProfiler::Get().BeginFrame(currentScene->GetName());
+        bool inputApplied = true;       // Everything that woke us has reached the scene
+        double updateStart = glfwGetTime();
+        double renderStart = updateStart;
+        hud.BeginSceneGpu();
+        if (options.threadedSim && sim.GetScene() == currentScene) {
+            PROFILE_ZONE("Render");
+            currentScene->OnRender(sim.GetAlpha());
+        } else {
+            int steps = simClock.Advance(frameTime);
+            inputApplied = steps > 0;
+            for (int i = 0; i < steps; i++) {
+                PROFILE_ZONE("Update");
+                currentScene->OnUpdate(simClock.GetStep(), input.BeginStep(simClock.GetStep()));
+            }
+            renderStart = glfwGetTime();
+            PROFILE_ZONE("Render");
+            currentScene->OnRender(simClock.GetAlpha());
         }
+        hud.EndSceneGpu();
+        double renderEnd = glfwGetTime();
 
-        // --- UPDATE & RENDER ---
-        currentScene->OnUpdate(0.016f);
-        currentScene->OnRender();
+        // --- HUD ---
+        // On top of the scene, after its GPU timer, so it doesn't time itself
+        if (hud.IsVisible()) {
+            int fbWidth, fbHeight;
+            glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+            hud.Draw(currentScene->GetName(), currentScene->GetMemoryUsage(), fbWidth, fbHeight);
+        }
+        hud.OnFrame(frameTime * 1000.0, (renderStart - updateStart) * 1000.0, (renderEnd - renderStart) * 1000.0);
 
         // --- SWAP ---
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        {
+            PROFILE_ZONE("Swap");
+            glfwSwapBuffers(window);
+        }
+        latency.OnFrameSwapped(currentScene->GetName(), glfwGetTime());
+
+        // Wait for the GPU / the frame cap *before* polling, so the next
+        // frame samples the freshest input
+        {
+            PROFILE_ZONE("Pace");
+            pacer.EndFrame();
+        }
+
+        // --- EVENTS ---
+        // Idle mode: a scene with nothing to animate sleeps here until input
+        // (or its own deadline) arrives, instead of redrawing the same frame.
+        // Keep polling while a load is pending or the last wake-up's input
+        // hasn't been stepped yet.
+        double idle = 0.0;
+        // (A replay's input never wakes the loop, so it always polls.)
+        if (options.idleRendering && options.replayPath.empty() && pendingSceneIndex == 0 && inputApplied) {
+            idle = currentScene->GetIdleTimeout();
+        }
+
+        PROFILE_ZONE("Poll");
+        if (idle <= 0.0) {
+            glfwPollEvents();
+        } else {
+            if (std::isinf(idle)) glfwWaitEvents();
+            else glfwWaitEventsTimeout(idle);
+
+            // Time spent asleep isn't simulated: wake up with exactly one step due
+            simClock.Reset();
+            lastTime = glfwGetTime() - SIM_STEP;
+        }
+    }
+
+    // Detach while the context still exists
+    sim.Stop();
+    loader.Stop();
+    if (!options.recordPath.empty()) {
+        if (recording.Save(options.recordPath)) {
+            std::cout << "Recorded " << recording.GetEntries().size() << " input events over "
+                      << recording.GetStepCount() << " steps to " << options.recordPath << std::endl;
+        } else {
+            std::cerr << "Failed to write " << options.recordPath << std::endl;
+        }
     }
+    scenes.Clear();
+    pacer.Release();
+    hud.Release();
+    GpuProfiler::Get().Release();
+    GpuProfiler::Get().PrintReport();
+    latency.PrintReport();
+    latency.Release();
+    if (Profiler::IsEnabled()) Profiler::WriteChromeTrace(options.traceOut);
 
     glfwTerminate();
     return 0;
@@ -1,11 +1,68 @@
 #pragma once
+#include "SceneContext.h"
+#include "../core/Input.h"
+#include "../core/GLStats.h"
+#include <cstddef>
+#include <limits>
 #include <string>
 
 class Scene {
 public:
     virtual ~Scene() = default;
+
+    // Heavy setup (file I/O, meshing, shader compiles). May run on the loader
+    // thread with a shared context current, so only create objects that are
+    // shared between contexts: buffers, textures, shaders, programs.
+    // No VAOs/FBOs here, and no global GL state.
+    virtual void OnLoad() {}
+    // Runs on the render thread once OnLoad is done and its GL work has landed
     virtual void OnAttach() = 0;
-    virtual void OnUpdate(float deltaTime) = 0;
-    virtual void OnRender() = 0;
-    virtual std::string GetName() const = 0;
+    // Called at a fixed rate (deltaTime is always the fixed step).
+    // 'input' is the only source of input, time and window size: scenes make
+    // no GLFW calls, so they behave the same on the sim thread and in replays.
+    virtual void OnUpdate(float deltaTime, const InputSnapshot& input) = 0;
+    // alpha = how far real time is between the last two updates (0..1),
+    // for interpolating anything that moves in OnUpdate
+    virtual void OnRender(float alpha) = 0;
+    virtual const char* GetName() const = 0;     // A literal: asked every frame, so no std::string
+
+    // --- Lifecycle (SceneCache) ---
+    // A scene is attached once, then suspended/resumed as the user switches
+    // away and back, and detached only when the cache drops it.
+    // OnSuspend: undo global GL state this scene changed. OnResume: set it again.
+    // OnDetach: free every GL object created in OnLoad/OnAttach. Also called
+    // for a loaded scene that was never attached.
+    virtual void OnSuspend() {}
+    virtual void OnResume() {}
+    virtual void OnDetach() {}
+
+    // Rough CPU + GPU bytes held while suspended; the cache evicts by this
+    virtual size_t GetMemoryUsage() const { return 0; }
+
+    // True if OnUpdate may run on the simulation thread (--sim-thread):
+    // it makes no GL calls and passes its results to OnRender through a
+    // TripleBuffer rather than plain members.
+    virtual bool SupportsThreadedUpdate() const { return false; }
+
+    // --- Idle rendering (--idle) ---
+    // Seconds until this scene's image would change without any new input,
+    // asked after each OnRender. 0 = animating, redraw every frame (default).
+    // IDLE_FOREVER = only input changes it. The host sleeps in the meantime.
+    static constexpr double IDLE_FOREVER = std::numeric_limits<double>::infinity();
+    virtual double GetIdleTimeout() const { return 0.0; }
+
+    // Set by the host right after construction, before OnLoad
+    void SetContext(SceneContext* context) { m_Context = context; }
+
+    // OnLoad couldn't get an asset the scene is about (e.g. its font). The
+    // scene still runs, but a benchmark of it would measure nothing.
+    bool HasLoadFailed() const { return m_LoadFailed; }
+
+protected:
+    SceneContext& GetContext() const { return *m_Context; }
+    void SetLoadFailed() { m_LoadFailed = true; }
+
+private:
+    SceneContext* m_Context = nullptr;
+    bool m_LoadFailed = false;
 };
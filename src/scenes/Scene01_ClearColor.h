@@ -1,27 +1,37 @@
 #pragma once
 #include "Scene.h"
+#include "SceneRegistry.h"
+#include "../core/GpuProfiler.h"
 #include <GL/glew.h>
+#include <GLFW/glfw3.h>
 #include <cmath>
 
 class Scene01_ClearColor : public Scene {
+    double m_Time = 0.0;        // Simulation time of the last update
+    float m_Step = 0.0f;
+
 public:
     void OnAttach() override {
         // Run once setup
     }
 
-    void OnUpdate(float deltaTime) override {
-        // Logic updates if needed
+    void OnUpdate(float deltaTime, const InputSnapshot& input) override {
+        m_Time = input.time;
+        m_Step = deltaTime;
     }
 
-    void OnRender() override {
+    void OnRender(float alpha) override {
         // Cycle background color over time
-        float time = (float)glfwGetTime();
+        float time = (float)(m_Time - (1.0f - alpha) * m_Step);   // Between the last two updates
         float r = (sin(time) / 2.0f) + 0.5f;
         float g = (cos(time) / 2.0f) + 0.5f;
         float b = (sin(time) / 2.0f) + 0.5f;
         glClearColor(r, g, b, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
+        GPU_ZONE("Clear");
+        GLStats::Clear(GL_COLOR_BUFFER_BIT);
     }
 
-    std::string GetName() const override { return "Scene 01: Clear Color"; }
+    const char* GetName() const override { return "Scene 01: Clear Color"; }
 };
+
+REGISTER_SCENE(Scene01_ClearColor, 1, "Scene 01: Clear Color", GLFW_KEY_1);
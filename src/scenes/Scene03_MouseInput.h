@@ -1,30 +1,33 @@
 #pragma once
 #include "Scene.h"
+#include "SceneRegistry.h"
+#include "../core/GpuProfiler.h"
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <cmath>
 #include <iostream>
 
 class Scene03_MouseInput : public Scene {
+    double mouseX = 0.0, mouseY = 0.0;
+    int width = 1, height = 1;
+
 public:
     void OnAttach() override {
         std::cout << "Scene 03 Loaded: Move your mouse!" << std::endl;
     }
 
-    void OnUpdate(float deltaTime) override {
-        // No manual update needed, we poll in Render
+    void OnUpdate(float deltaTime, const InputSnapshot& input) override {
+        // Latest cursor and window size, for OnRender
+        mouseX = input.cursorX;
+        mouseY = input.cursorY;
+        if (input.windowWidth > 0 && input.windowHeight > 0) {
+            width = input.windowWidth;
+            height = input.windowHeight;
+        }
     }
 
-    void OnRender() override {
-        GLFWwindow* window = glfwGetCurrentContext();
-
-        // 1. Get Mouse Position
-        double mouseX, mouseY;
-        glfwGetCursorPos(window, &mouseX, &mouseY);
-
-        // 2. Get Window Size
-        int width, height;
-        glfwGetWindowSize(window, &width, &height);
+    void OnRender(float alpha) override {
+        // 1. Mouse Position and 2. Window Size come from the last update
 
         // --- COORDINATE FIX ---
         // GLFW (Window System): (0,0) is TOP-Left.
@@ -42,8 +45,12 @@ public:
         // 3. Clear Background
         // Blue when high (Top), Dark when low (Bottom)
         glClearColor(0.1f, 0.1f, heightRatio, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
+        {
+            GPU_ZONE("Clear");
+            GLStats::Clear(GL_COLOR_BUFFER_BIT);
+        }
 
+        GPU_ZONE("Scissor");
         glEnable(GL_SCISSOR_TEST);
 
         // --- FEATURE: STARS ---
@@ -62,7 +69,7 @@ public:
                 
                 // Draw a tiny 2x2 box for each star
                 glScissor(starX, starY, 2, 2); 
-                glClear(GL_COLOR_BUFFER_BIT);
+                GLStats::Clear(GL_COLOR_BUFFER_BIT);
             }
         }
 
@@ -79,10 +86,15 @@ public:
         glScissor((int)mouseX - (boxSize/2), glMouseY - (boxSize/2), boxSize, boxSize);
         
         glClearColor(1.0f, 0.8f, 0.2f, 1.0f); // Gold color
-        glClear(GL_COLOR_BUFFER_BIT);
+        GLStats::Clear(GL_COLOR_BUFFER_BIT);
 
         glDisable(GL_SCISSOR_TEST);
     }
 
-    std::string GetName() const override { return "Scene 03: Mouse & Pulse"; }
+    // The picture is a function of the cursor and window size alone
+    double GetIdleTimeout() const override { return IDLE_FOREVER; }
+
+    const char* GetName() const override { return "Scene 03: Mouse & Pulse"; }
 };
+
+REGISTER_SCENE(Scene03_MouseInput, 3, "Scene 03: Mouse & Pulse", GLFW_KEY_3);
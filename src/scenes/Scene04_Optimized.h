@@ -1,6 +1,9 @@
 #pragma once
 #include "Scene.h"
+#include "SceneRegistry.h"
 #include "../core/TextRenderer3D.h"
+#include "../core/GlyphCorpus.h"
+#include "../core/GpuProfiler.h"
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
@@ -110,16 +113,28 @@ void main()
 // --- C++ CLASS DEFINITION ---
 class Scene04_Optimized : public Scene {
     TextRenderer3D m_TextSystem;
-    GLuint m_Shader;
+    GLuint m_Shader = 0;
+    double m_Time = 0.0;        // Simulation time of the last update
+    float m_Step = 0.0f;
+    float m_Aspect = 16.0f / 9.0f;
+    const std::string m_Label = "KLAPPA";
 
 public:
-    void OnAttach() override {
-        // 1. Load Font
-        std::string fontPath = "/home/hugo/Work/resources/font/ttf/LineLineShapeDirty.ttf";
+    // Everything here is file I/O, meshing and shader compiles: fine on the loader thread
+    void OnLoad() override {
+        // 1. Load Font (only the glyphs of the label get meshed, in parallel)
+        m_TextSystem.SetJobSystem(GetContext().jobs);
+        GlyphCorpus corpus;
+        corpus.AddString(m_Label);
+        m_TextSystem.SetGlyphCorpus(corpus);
+
+        std::string fontPath = GetContext().fontPath;
+        if (fontPath.empty()) fontPath = "/home/hugo/Work/resources/font/ttf/LineLineShapeDirty.ttf";
         if(m_TextSystem.LoadFont(fontPath)) {
             std::cout << "Scene04: Loaded font: " << fontPath << std::endl;
         } else {
-            std::cerr << "Scene04: ERROR - Could not find font at: " << fontPath << std::endl;
+            std::cerr << "Scene04: ERROR - Could not find font at: " << fontPath << " (--font)" << std::endl;
+            SetLoadFailed();
         }
 
         // 2. Compile Shaders
@@ -144,24 +159,52 @@ public:
         glAttachShader(m_Shader, vs); 
         glAttachShader(m_Shader, fs); 
         glLinkProgram(m_Shader);
+
+        // The program keeps the compiled code
+        glDeleteShader(vs);
+        glDeleteShader(fs);
+    }
+
+    void OnAttach() override {
+        // Glyph VAOs are made on first draw, on this context
+    }
+
+    void OnSuspend() override {
+        // OnRender turns this on; the other scenes don't expect it
+        glDisable(GL_DEPTH_TEST);
     }
 
-    void OnUpdate(float dt) override {}
+    void OnDetach() override {
+        glDeleteProgram(m_Shader);
+        m_Shader = 0;
+    }
+
+    size_t GetMemoryUsage() const override { return m_TextSystem.GetMemoryUsage(); }
 
-    void OnRender() override {
+    void OnUpdate(float dt, const InputSnapshot& input) override {
+        m_Time = input.time;
+        m_Step = dt;
+        if (input.windowWidth > 0 && input.windowHeight > 0) {
+            m_Aspect = (float)input.windowWidth / (float)input.windowHeight;
+        }
+    }
+
+    void OnRender(float alpha) override {
         glClearColor(0.188f, 0.003f, 0.314f, 1.0f); // Match Shadow Color
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        {
+            GPU_ZONE("Clear");
+            GLStats::Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        }
         glEnable(GL_DEPTH_TEST);
         glUseProgram(m_Shader);
         
-        int w, h; glfwGetWindowSize(glfwGetCurrentContext(), &w, &h);
-        float aspect = (float)w / (float)h;
+        float aspect = m_Aspect;
         
         // --- MATRICES ---
         glm::mat4 projection = glm::perspective(glm::radians(45.0f), aspect, 0.1f, 100.0f);
         glm::mat4 view = glm::lookAt(glm::vec3(0, 0, 15), glm::vec3(0, 0, 0), glm::vec3(0, 1, 0));
         
-        float time = (float)glfwGetTime();
+        float time = (float)(m_Time - (1.0f - alpha) * m_Step);   // Between the last two updates
         
         // Global Rotation
         glm::mat4 model = glm::rotate(glm::mat4(1.0f), time * 0.1f, glm::vec3(0.0f, 1.0f, 0.0f)); 
@@ -179,8 +222,11 @@ public:
 
         // Render Text
         // Scale 0.005, Depth 1.0
-        m_TextSystem.RenderText("KLAPPA", -4.0f, -0.5f, 0.005f, 1.0f, m_Shader, glm::value_ptr(mvpBase));
+        GPU_ZONE("Text (halftone)");
+        m_TextSystem.RenderText(m_Label, -4.0f, -0.5f, 0.005f, 1.0f, m_Shader, glm::value_ptr(mvpBase));
     }
 
-    std::string GetName() const override { return "Scene 04: Klaffa Style"; }
+    const char* GetName() const override { return "Scene 04: Klaffa Style"; }
 };
+
+REGISTER_SCENE(Scene04_Optimized, 4, "Scene 04: Klaffa Style", GLFW_KEY_4);
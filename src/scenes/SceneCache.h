@@ -0,0 +1,124 @@
+#pragma once
+#include "Scene.h"
+#include "SceneRegistry.h"
+#include "../core/Profiler.h"
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <memory>
+
+// Keeps recently used scenes attached so switching back to one is just
+// OnSuspend + OnResume instead of a full rebuild. Suspended scenes are
+// detached and destroyed, least recently used first, once their combined
+// GetMemoryUsage() goes over the budget. The active scene is never evicted.
+class SceneCache {
+    struct Entry {
+        int id;
+        std::unique_ptr<Scene> scene;
+        bool attached = true;       // False for a loaded scene never made active
+    };
+
+    std::list<Entry> m_Entries;     // Front = active, then most recently used
+    size_t m_Budget;
+    SceneContext* m_Context;
+
+public:
+    SceneCache(size_t budgetBytes, SceneContext* context) : m_Budget(budgetBytes), m_Context(context) {}
+    ~SceneCache() { Clear(); }
+
+    Scene* GetActive() { return m_Entries.empty() ? nullptr : m_Entries.front().scene.get(); }
+    int GetActiveId() const { return m_Entries.empty() ? 0 : m_Entries.front().id; }
+
+    bool Contains(int id) const {
+        for (const Entry& e : m_Entries) {
+            if (e.id == id) return true;
+        }
+        return false;
+    }
+
+    // Makes scene 'id' the active one, loading it here and now if it isn't
+    // cached (see SceneLoader for the background path). Null for an unknown id.
+    Scene* Activate(int id) {
+        if (!m_Entries.empty() && m_Entries.front().id == id) return GetActive();
+
+        if (!SceneRegistry::Get().FindById(id)) return nullptr;
+
+        if (Scene* current = GetActive()) current->OnSuspend();
+
+        // 1. Warm: already loaded, move it to the front
+        for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it) {
+            if (it->id == id) {
+                m_Entries.splice(m_Entries.begin(), m_Entries, it);
+                if (it->attached) {
+                    GetActive()->OnResume();
+                } else {
+                    PROFILE_ZONE("Scene::OnAttach");
+                    GetActive()->OnAttach();
+                    it->attached = true;
+                }
+                Trim();
+                return GetActive();
+            }
+        }
+
+        // 2. Cold: build, load and attach
+        std::unique_ptr<Scene> scene = SceneRegistry::Get().Create(id, m_Context);
+        {
+            PROFILE_ZONE("Scene::OnLoad");
+            scene->OnLoad();
+        }
+        m_Entries.push_front({ id, std::move(scene) });
+        {
+            PROFILE_ZONE("Scene::OnAttach");
+            GetActive()->OnAttach();
+        }
+        Trim();
+        return GetActive();
+    }
+
+    // Takes a scene whose OnLoad already ran elsewhere, attaches it and makes it active
+    Scene* Adopt(int id, std::unique_ptr<Scene> scene) {
+        if (Scene* current = GetActive()) current->OnSuspend();
+        m_Entries.push_front({ id, std::move(scene) });
+        {
+            PROFILE_ZONE("Scene::OnAttach");
+            GetActive()->OnAttach();
+        }
+        Trim();
+        return GetActive();
+    }
+
+    // Keeps a scene whose OnLoad already ran elsewhere without making it active,
+    // e.g. a background load the user switched away from before it finished.
+    // It goes in as the most recently used suspended scene and is attached on
+    // its first Activate(); the budget decides whether it stays until then.
+    void AdoptSuspended(int id, std::unique_ptr<Scene> scene) {
+        if (m_Entries.empty() || Contains(id)) {
+            scene->OnDetach();
+            return;
+        }
+        m_Entries.insert(std::next(m_Entries.begin()), { id, std::move(scene), false });
+        Trim();
+    }
+
+    void Clear() {
+        for (Entry& e : m_Entries) e.scene->OnDetach();
+        m_Entries.clear();
+    }
+
+private:
+    // The budget is for the suspended scenes: the active one doesn't count
+    void Trim() {
+        if (m_Entries.empty()) return;
+        size_t total = 0;
+        for (auto it = std::next(m_Entries.begin()); it != m_Entries.end(); ++it) total += it->scene->GetMemoryUsage();
+
+        while (total > m_Budget && m_Entries.size() > 1) {
+            Entry& victim = m_Entries.back();
+            total -= victim.scene->GetMemoryUsage();
+            std::cout << "SceneCache: dropping " << victim.scene->GetName() << std::endl;
+            victim.scene->OnDetach();
+            m_Entries.pop_back();
+        }
+    }
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+class JobSystem;
+
+// Application services handed to every scene (Scene::GetContext()).
+// Owned by main(); outlives all scenes.
+struct SceneContext {
+    JobSystem* jobs = nullptr;          // Work-stealing scheduler, usable from any scene hook
+    std::string fontPath;               // --font: overrides the text scenes' font (empty = their own)
+};
@@ -0,0 +1,154 @@
+#pragma once
+#include "Scene.h"
+#include "SceneRegistry.h"
+#include "../core/Profiler.h"
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Runs Scene::OnLoad for cold scenes on a background thread, on a hidden
+// GLFW window whose context shares objects with the main one. When OnLoad
+// returns, the loader drops a fence; TakeReady() hands the scene over only
+// after the GPU has passed it, so the render thread never waits on uploads
+// and keeps drawing the current scene for the whole transition.
+//
+// One scene is loaded at a time. A new Request() replaces one that hasn't
+// started yet.
+class SceneLoader {
+    GLFWwindow* m_Context = nullptr;
+    SceneContext* m_SceneContext = nullptr;
+    std::thread m_Thread;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_Wake;
+    bool m_Quit = false;
+
+    // Main -> loader
+    int m_RequestId = 0;
+    std::unique_ptr<Scene> m_Request;
+    int m_LoadingId = 0;
+
+    // Loader -> main
+    int m_ReadyId = 0;
+    std::unique_ptr<Scene> m_Ready;
+    GLsync m_ReadyFence = 0;
+
+public:
+    ~SceneLoader() { Stop(); }
+
+    // Call on the main thread with the main context current
+    bool Start(GLFWwindow* shareWith, SceneContext* sceneContext) {
+        m_SceneContext = sceneContext;
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        m_Context = glfwCreateWindow(1, 1, "GraphicsLab Loader", NULL, shareWith);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+        if (m_Context == NULL) {
+            std::cerr << "SceneLoader: no shared context, scenes will load on the main thread" << std::endl;
+            return false;
+        }
+
+        m_Thread = std::thread([this]() { Run(); });
+        return true;
+    }
+
+    // Call before the main context goes away
+    void Stop() {
+        if (!m_Thread.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Quit = true;
+        }
+        m_Wake.notify_all();
+        m_Thread.join();
+
+        // Whatever never got handed over
+        if (m_Request) m_Request->OnDetach();
+        if (m_Ready) m_Ready->OnDetach();
+        if (m_ReadyFence) glDeleteSync(m_ReadyFence);
+        m_Request.reset();
+        m_Ready.reset();
+        m_ReadyFence = 0;
+
+        glfwDestroyWindow(m_Context);
+        m_Context = nullptr;
+    }
+
+    bool IsRunning() const { return m_Context != nullptr; }
+
+    // Queues scene 'id' (constructed here, loaded on the loader thread)
+    void Request(int id) {
+        std::unique_ptr<Scene> scene = SceneRegistry::Get().Create(id, m_SceneContext);
+        if (!scene) return;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_LoadingId == id || m_RequestId == id || m_ReadyId == id) return;
+            m_Request = std::move(scene);   // An older, unstarted request is simply dropped
+            m_RequestId = id;
+        }
+        m_Wake.notify_all();
+    }
+
+    // Non-blocking. Returns the loaded scene once its GL work has completed.
+    std::unique_ptr<Scene> TakeReady(int& id) {
+        std::unique_ptr<Scene> ready;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (!m_Ready) return nullptr;
+
+            GLenum state = glClientWaitSync(m_ReadyFence, 0, 0);
+            if (state != GL_ALREADY_SIGNALED && state != GL_CONDITION_SATISFIED) return nullptr;
+
+            glDeleteSync(m_ReadyFence);
+            m_ReadyFence = 0;
+            ready = std::move(m_Ready);
+            id = m_ReadyId;
+            m_ReadyId = 0;
+        }
+        m_Wake.notify_all();
+        return ready;
+    }
+
+private:
+    void Run() {
+        Profiler::SetThreadName("Scene loader");
+        glfwMakeContextCurrent(m_Context);
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        while (true) {
+            // Wait for work, and for the previous result to be picked up
+            m_Wake.wait(lock, [this]() { return m_Quit || (m_Request && !m_Ready); });
+            if (m_Quit) break;
+
+            std::unique_ptr<Scene> scene = std::move(m_Request);
+            int id = m_RequestId;
+            m_RequestId = 0;
+            m_LoadingId = id;
+            lock.unlock();
+
+            // 1. The heavy part, off the render thread
+            {
+                PROFILE_ZONE("Scene::OnLoad");
+                scene->OnLoad();
+            }
+
+            // 2. Fence + flush so the main context can tell when it has landed
+            GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+
+            lock.lock();
+            m_Ready = std::move(scene);
+            m_ReadyId = id;
+            m_ReadyFence = fence;
+            m_LoadingId = 0;
+
+            // Wake the main thread if it is sleeping in idle mode
+            glfwPostEmptyEvent();
+        }
+
+        glfwMakeContextCurrent(NULL);
+    }
+};
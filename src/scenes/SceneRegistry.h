@@ -0,0 +1,76 @@
+#pragma once
+#include "Scene.h"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Every scene registers itself here (see REGISTER_SCENE at the bottom of each
+// scene header). The host never names a scene type: it looks scenes up by id
+// or by hotkey, so adding scene N is one line in that scene's own header.
+struct SceneInfo {
+    int id;
+    std::string name;
+    int hotkey;                                     // GLFW_KEY_*, or 0 for none
+    std::function<std::unique_ptr<Scene>()> create;
+};
+
+class SceneRegistry {
+    std::vector<SceneInfo> m_Scenes;                // Sorted by id
+    std::unordered_map<int, size_t> m_ById;
+    std::unordered_map<int, size_t> m_ByKey;
+
+public:
+    static SceneRegistry& Get() {
+        static SceneRegistry instance;
+        return instance;
+    }
+
+    void Register(SceneInfo info) {
+        auto it = std::lower_bound(m_Scenes.begin(), m_Scenes.end(), info.id,
+            [](const SceneInfo& s, int id) { return s.id < id; });
+        m_Scenes.insert(it, std::move(info));
+
+        // Rebuild the lookup tables (registration only happens at startup)
+        m_ById.clear();
+        m_ByKey.clear();
+        for (size_t i = 0; i < m_Scenes.size(); i++) {
+            m_ById[m_Scenes[i].id] = i;
+            if (m_Scenes[i].hotkey != 0) m_ByKey[m_Scenes[i].hotkey] = i;
+        }
+    }
+
+    const SceneInfo* FindById(int id) const {
+        auto it = m_ById.find(id);
+        return it != m_ById.end() ? &m_Scenes[it->second] : nullptr;
+    }
+
+    const SceneInfo* FindByKey(int key) const {
+        auto it = m_ByKey.find(key);
+        return it != m_ByKey.end() ? &m_Scenes[it->second] : nullptr;
+    }
+
+    const std::vector<SceneInfo>& GetScenes() const { return m_Scenes; }
+
+    // Builds scene 'id' wired to 'context' (null for an unknown id)
+    std::unique_ptr<Scene> Create(int id, SceneContext* context) const {
+        const SceneInfo* info = FindById(id);
+        if (!info) return nullptr;
+        std::unique_ptr<Scene> scene = info->create();
+        scene->SetContext(context);
+        return scene;
+    }
+};
+
+template <typename T>
+struct SceneRegistrar {
+    SceneRegistrar(int id, const char* name, int hotkey) {
+        SceneRegistry::Get().Register({ id, name, hotkey, [] { return std::unique_ptr<Scene>(new T()); } });
+    }
+};
+
+// Usage (at namespace scope, after the class): REGISTER_SCENE(Scene05_Foo, 5, "Scene 05: Foo", GLFW_KEY_5);
+#define REGISTER_SCENE(Type, id, name, hotkey) \
+    inline SceneRegistrar<Type> g_Register_##Type{ id, name, hotkey }
@@ -0,0 +1,110 @@
+#pragma once
+#include "Scene.h"
+#include "../core/FixedTimestep.h"
+#include "../core/Input.h"
+#include "../core/Profiler.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Optional mode (--sim-thread): runs the active scene's fixed-step OnUpdate
+// on its own thread, so a heavy simulation overlaps with rendering instead
+// of adding to it. Only scenes that say SupportsThreadedUpdate() go here;
+// they hand state to OnRender through a TripleBuffer.
+//
+// Input reaches the scene only as the InputSnapshot built from events the
+// main thread's GLFW callbacks queued; nothing on this thread polls GLFW for
+// input. Its one GLFW call is glfwGetTime, which may be called from any thread.
+class SimulationThread {
+    std::thread m_Thread;
+    std::mutex m_Mutex;                 // Held for the whole of each batch of steps
+    std::condition_variable m_Wake;
+    bool m_Quit = false;
+
+    // Written under m_Mutex (main thread only); GetScene() reads it without
+    // the lock so the render thread never waits behind a batch of steps
+    std::atomic<Scene*> m_Scene{ nullptr };
+    InputSystem* m_Input = nullptr;     // Drained here while a scene is simulated
+    FixedTimestep m_Clock;
+    double m_LastTime = 0.0;
+    std::atomic<double> m_LastStepTime{ 0.0 };
+
+public:
+    ~SimulationThread() { Stop(); }
+
+    void Start(double step, int maxSteps, InputSystem* input) {
+        m_Input = input;
+        m_Clock = FixedTimestep(step, maxSteps);
+        m_Thread = std::thread([this]() { Run(); });
+    }
+
+    void Stop() {
+        if (!m_Thread.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Quit = true;
+        }
+        m_Wake.notify_all();
+        m_Thread.join();
+    }
+
+    bool IsRunning() const { return m_Thread.joinable(); }
+
+    // Swaps the simulated scene (main thread only). Returns only after any step
+    // in progress has finished, so SetScene(nullptr) makes the old scene safe
+    // to suspend.
+    void SetScene(Scene* scene) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Scene = scene;
+            m_Clock.Reset();
+            m_LastTime = glfwGetTime();
+            m_LastStepTime = m_LastTime;
+        }
+        m_Wake.notify_all();
+    }
+
+    Scene* GetScene() const { return m_Scene.load(); }
+
+    // Render alpha: how far real time is past the newest snapshot, in steps.
+    // Snapshots carry the previous state too, so this blends the last two.
+    float GetAlpha() const {
+        double t = (glfwGetTime() - m_LastStepTime.load()) / m_Clock.GetStep();
+        return (float)std::min(std::max(t, 0.0), 1.0);
+    }
+
+private:
+    void Run() {
+        Profiler::SetThreadName("Simulation");
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        while (true) {
+            m_Wake.wait(lock, [this]() { return m_Quit || m_Scene.load(); });
+            if (m_Quit) break;
+
+            // 1. Catch up with real time
+            double now = glfwGetTime();
+            int steps = m_Clock.Advance(now - m_LastTime);
+            m_LastTime = now;
+            int events = 0;
+            Scene* scene = m_Scene.load();     // Can't change while we hold the lock
+            for (int i = 0; i < steps; i++) {
+                PROFILE_ZONE("Update");
+                const InputSnapshot& input = m_Input->BeginStep(m_Clock.GetStep());
+                events += input.eventCount;
+                scene->OnUpdate(m_Clock.GetStep(), input);
+            }
+            if (steps > 0) m_LastStepTime = now;
+
+            // An idle main thread has to see what that input did
+            if (events > 0) glfwPostEmptyEvent();
+
+            // 2. Sleep until the next step is due (wakes early on SetScene/Stop)
+            double wait = (1.0 - m_Clock.GetAlpha()) * m_Clock.GetStep();
+            m_Wake.wait_for(lock, std::chrono::duration<double>(wait));
+        }
+    }
+};
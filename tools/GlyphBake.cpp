@@ -0,0 +1,129 @@
+// GlyphBake - tessellates a font offline and writes a compressed .glyphs archive
+// that TextRenderer3D::LoadGlyphArchive() can load without touching the font.
+//
+// Usage: GlyphBake <font.ttf> <out.glyphs> [--face N] [--range FIRST-LAST]
+//                  [--corpus FILE] [--text STRING]
+//        Ranges accept decimal or 0x-prefixed hex, e.g. --range 0x4E00-0x9FFF,
+//        up to 0x10FFFF. Surrogates (0xD800-0xDFFF) inside a range are skipped.
+//        --corpus / --text bake only the glyphs that text actually uses (kiosk builds).
+//        With no range and no corpus, bakes printable ASCII (32-126), same as LoadFont().
+//        --face picks a face inside a collection (.ttc).
+
+#include "core/GlyphTessellator.h"
+#include "core/GlyphArchive.h"
+#include "core/FontFile.h"
+#include "core/GlyphCorpus.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// A whole decimal or 0x-prefixed hex number, nothing before or after it
+static bool ParseCodepoint(const std::string& s, uint32_t& cp) {
+    if (s.empty() || !std::isxdigit((unsigned char)s[0])) return false;
+    char* end = nullptr;
+    unsigned long v = std::strtoul(s.c_str(), &end, 0);
+    if (*end != '\0' || v > 0x10FFFF) return false;
+    cp = (uint32_t)v;
+    return true;
+}
+
+// Valid Unicode scalar values only: at most U+10FFFF, and not nothing but surrogates
+static bool ParseRange(const std::string& s, uint32_t& first, uint32_t& last) {
+    size_t dash = s.find('-');
+    if (dash == std::string::npos) return false;
+    if (!ParseCodepoint(s.substr(0, dash), first) || !ParseCodepoint(s.substr(dash + 1), last)) return false;
+    if (first >= 0xD800 && last <= 0xDFFF) return false;
+    return first <= last;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: GlyphBake <font.ttf> <out.glyphs> [--face N] [--range FIRST-LAST]"
+                  << " [--corpus FILE] [--text STRING]" << std::endl;
+        return 1;
+    }
+
+    std::string fontPath = argv[1];
+    std::string outPath = argv[2];
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    int faceIndex = 0;
+    GlyphCorpus corpus;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--range" && i + 1 < argc) {
+            uint32_t first, last;
+            if (!ParseRange(argv[++i], first, last)) {
+                std::cerr << "Bad range: " << argv[i] << std::endl;
+                return 1;
+            }
+            ranges.push_back({first, last});
+        } else if (arg == "--corpus" && i + 1 < argc) {
+            if (!corpus.AddFile(argv[++i])) {
+                std::cerr << "Could not read corpus: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "--text" && i + 1 < argc) {
+            corpus.AddString(argv[++i]);
+        } else if (arg == "--face" && i + 1 < argc) {
+            faceIndex = std::atoi(argv[++i]);
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 1;
+        }
+    }
+    if (ranges.empty() && corpus.IsEmpty()) ranges.push_back({32, 126});
+
+    std::vector<uint32_t> codepoints = corpus.GetCodepoints();
+    for (const auto& range : ranges) {
+        for (uint32_t cp = range.first; cp <= range.second; ++cp) {
+            if (cp < 0xD800 || cp > 0xDFFF) codepoints.push_back(cp);
+        }
+    }
+    std::sort(codepoints.begin(), codepoints.end());
+    codepoints.erase(std::unique(codepoints.begin(), codepoints.end()), codepoints.end());
+
+    // 1. Load Font
+    std::shared_ptr<FontFile> file = FontFile::Open(fontPath);
+    if (!file) { std::cerr << "Could not open font: " << fontPath << std::endl; return 1; }
+
+    FontFace face;
+    if (!face.Init(file, faceIndex)) {
+        std::cerr << "No face " << faceIndex << " in " << fontPath << " (" << file->GetFaceCount() << " faces)" << std::endl;
+        return 1;
+    }
+    const stbtt_fontinfo& info = face.info;
+
+    // 2. Tessellate + Encode
+    GlyphArchiveWriter writer;
+    GlyphGeometry geometry;
+    size_t rawBytes = 0;
+    size_t missing = 0;
+    for (uint32_t cp : codepoints) {
+        int glyphIndex = stbtt_FindGlyphIndex(&info, cp);
+        if (glyphIndex == 0) {
+            // Only worth reporting for text the kiosk will actually show
+            if (!corpus.IsEmpty()) ++missing;
+            continue;
+        }
+
+        TessellateGlyph(&info, glyphIndex, geometry);
+        writer.AddGlyph(cp, geometry);
+        rawBytes += geometry.vertices.size() * sizeof(float) + geometry.indices.size() * sizeof(uint32_t);
+    }
+
+    // 3. Write
+    if (!writer.Write(outPath)) { std::cerr << "Could not write: " << outPath << std::endl; return 1; }
+
+    std::cout << "Baked " << writer.GetGlyphCount() << " glyphs: "
+              << rawBytes << " raw bytes -> " << writer.GetEncodedBytes() << " encoded bytes" << std::endl;
+    if (missing > 0) {
+        std::cerr << "Warning: " << missing << " requested codepoints are not in this face" << std::endl;
+    }
+    return 0;
+}
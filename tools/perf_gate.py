@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""Performance regression gate.
+
+Runs the glyph pipeline micro-benchmarks (GlyphPipelineBench) and the headless
+scene benchmarks (GraphicsLab --bench) several times, and compares the median
+of each metric with a checked-in baseline. A metric fails when its median is
+above
+
+    baseline median + max(tolerance * baseline median, 3 * sigma, noise floor)
+
+where sigma is estimated from the median absolute deviation (1.4826 * MAD)
+of the noisier of the two sets of runs, and the noise floor is an absolute
+allowance for metrics so small that a timer tick or a scheduler hiccup is a
+large relative change: "noise_floor_ms" in the baseline config, but never
+more than the baseline median itself, so a tiny metric still fails when it
+doubles. Exits 1 and names the offending stage(s) on a regression.
+
+Scenes run every registered scene. gpu_ms is left out when the renderer is a
+software rasterizer (llvmpipe, softpipe, swrast, SwiftShader): it does the
+frame's work on the CPU before the timer query ends, so the query measures
+nothing and update/render/total already cover the cost.
+
+Usage:
+    perf_gate.py --build-dir BUILD [--baseline bench/perf_baseline.json] [--runs N]
+                 [--only glyphs|scenes] [--update]
+
+--update re-measures and rewrites the baseline (keeping its config). Do that
+on the machine the gate runs on; numbers don't carry across machines.
+
+A scene entry may name an input recording to replay ("replay": "scene02.input",
+made with GraphicsLab --record) and a metric prefix ("name"), so interactive
+scenes are measured under the same input every run, and a font for text scenes
+("font", passed as --font): point it at one the gate machine has. A scene that
+can't load its assets fails the run rather than timing an empty frame.
+"""
+
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+
+MAD_TO_SIGMA = 1.4826
+SIGMAS = 3.0
+NOISE_FLOOR_MS = 0.05               # Default for the config's "noise_floor_ms"
+
+# Scene metrics worth gating: tails beyond p95 are too noisy over a few hundred frames
+SCENE_METRICS = [("update_ms", "p50"), ("render_ms", "p50"), ("gpu_ms", "p50"),
+                 ("total_ms", "p50"), ("total_ms", "p95")]
+
+# GL_RENDERER substrings of rasterizers whose GPU timer queries read ~0
+SOFTWARE_RENDERERS = ("llvmpipe", "softpipe", "swrast", "SwiftShader")
+
+
+def is_software(renderer):
+    return any(name.lower() in renderer.lower() for name in SOFTWARE_RENDERERS)
+
+
+def median_mad(values):
+    m = statistics.median(values)
+    return m, statistics.median(abs(v - m) for v in values)
+
+
+def run_json(cmd, out_path):
+    result = subprocess.run(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+    if result.returncode != 0:
+        sys.exit("perf_gate: '%s' failed (%d)\n%s" % (" ".join(cmd), result.returncode, result.stderr))
+    with open(out_path) as f:
+        return json.load(f)
+
+
+def measure_glyphs(build_dir, config, runs, samples):
+    exe = os.path.join(build_dir, "GlyphPipelineBench")
+    with tempfile.TemporaryDirectory() as tmp:
+        out = os.path.join(tmp, "glyphs.json")
+        cmd = [exe] + config["fonts"] + ["--iterations", str(config.get("iterations", 15)), "--json", out]
+        for _ in range(runs):
+            for font in run_json(cmd, out)["fonts"]:
+                name = os.path.splitext(os.path.basename(font["font"]))[0]
+                for stage, values in font["stages"].items():
+                    samples.setdefault("glyphs/%s/%s" % (name, stage), []).append(values["font_ms"])
+
+
+def measure_scenes(build_dir, config, runs, samples, baseline_dir):
+    exe = os.path.join(build_dir, "GraphicsLab")
+    with tempfile.TemporaryDirectory() as tmp:
+        out = os.path.join(tmp, "scene.json")
+        for scene in config:
+            cmd = [exe, "--bench", str(scene["id"]), "--frames", str(scene.get("frames", 300)),
+                   "--size", scene.get("size", "1280x720"), "--bench-out", out]
+            # Optional input recording (GraphicsLab --record), relative to the baseline file
+            if "replay" in scene:
+                cmd += ["--replay", os.path.join(baseline_dir, scene["replay"])]
+            if "font" in scene:
+                cmd += ["--font", scene["font"]]
+            name = scene.get("name", "scene%02d" % scene["id"])
+            for _ in range(runs):
+                report = run_json(cmd, out)
+                for metric, pct in SCENE_METRICS:
+                    if metric == "gpu_ms" and is_software(report.get("renderer", "")):
+                        continue
+                    key = "%s/%s.%s" % (name, metric, pct)
+                    samples.setdefault(key, []).append(report[metric][pct])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Fail when benchmarks regress against a stored baseline.")
+    parser.add_argument("--build-dir", required=True)
+    parser.add_argument("--baseline", default=os.path.join(os.path.dirname(__file__), "..", "bench", "perf_baseline.json"))
+    parser.add_argument("--runs", type=int, default=0, help="repetitions per benchmark (default: baseline's)")
+    parser.add_argument("--only", choices=["glyphs", "scenes"])
+    parser.add_argument("--update", action="store_true", help="rewrite the baseline from this machine")
+    args = parser.parse_args()
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+    config = baseline["config"]
+    runs = args.runs or config.get("runs", 5)
+    tolerance = config.get("tolerance", 0.10)
+    noise_floor = config.get("noise_floor_ms", NOISE_FLOOR_MS)
+
+    # 1. Measure
+    samples = {}
+    if args.only != "scenes":
+        measure_glyphs(args.build_dir, config["glyphs"], runs, samples)
+    if args.only != "glyphs":
+        measure_scenes(args.build_dir, config["scenes"], runs, samples, os.path.dirname(os.path.abspath(args.baseline)))
+
+    current = {}
+    for key, values in samples.items():
+        m, mad = median_mad(values)
+        current[key] = {"median": round(m, 5), "mad": round(mad, 5)}
+
+    if args.update:
+        baseline["metrics"].update(current)
+        with open(args.baseline, "w") as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("perf_gate: wrote %d metrics to %s" % (len(current), args.baseline))
+        return 0
+
+    # 2. Compare
+    failures = []
+    print("%-36s %11s %11s %8s %8s" % ("metric (ms)", "baseline", "current", "delta", "limit"))
+    for key in sorted(current):
+        cur = current[key]
+        base = baseline["metrics"].get(key)
+        if base is None:
+            print("%-36s %11s %11.4f %8s %8s  (no baseline)" % (key, "-", cur["median"], "", ""))
+            continue
+
+        sigma = MAD_TO_SIGMA * max(base["mad"], cur["mad"])
+        allowed = max(tolerance * base["median"], SIGMAS * sigma, min(noise_floor, base["median"]))
+        delta = cur["median"] - base["median"]
+        rel = delta / base["median"] if base["median"] > 0 else 0.0
+        limit = allowed / base["median"] if base["median"] > 0 else 0.0
+        regressed = delta > allowed
+
+        print("%-36s %11.4f %11.4f %+7.1f%% %+7.1f%%%s" % (key, base["median"], cur["median"],
+              100 * rel, 100 * limit, "  REGRESSION" if regressed else ""))
+        if regressed:
+            failures.append((key, base["median"], cur["median"], rel, limit))
+
+    missing = sorted(set(baseline["metrics"]) - set(current))
+    if args.only is None and missing:
+        print("perf_gate: not measured (benchmark output changed?): %s" % ", ".join(missing))
+
+    if failures:
+        print()
+        for key, base, cur, rel, limit in failures:
+            print("perf_gate: %s regressed: %.4f -> %.4f ms (%+.1f%%, allowed %+.1f%%)" % (key, base, cur, 100 * rel, 100 * limit))
+        return 1
+
+    print("perf_gate: %d metrics within tolerance" % len(current))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())